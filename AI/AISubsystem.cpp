@@ -3,16 +3,22 @@
 #include "AI/Controllers/AIDecisionController.h"
 #include "AI/Gateway/AIServiceGateway.h"
 #include "Tank.h"
+#include "CoreBullet/Bullet.h"
 
 #include "Services/Pathfinding/Pathfinding.h"
+#include "Services/Pathfinding/Async/AsyncPlanner.h"
 #include "Services/Motion/Motion.h"
 #include "Services/Combat/Combat.h"
 #include "Services/Sensing/Sensing.h"
 #include "Services/Sensing/Audio/Bus.h"
+#include "Services/Sensing/Vision/VisibilityMatrix.h"
 
 #include "AI/Data/AIContext.h"
+#include "Helper/Geometry.h"
 
+#include <algorithm>
 #include <ranges>
+#include <cmath>
 
 #ifdef AI_DEBUG
 #include "Debug/AIDebugOverlay.h"
@@ -24,6 +30,7 @@ AISubsystem::AISubsystem()
 {
     pathfinding_ = std::make_unique<Pathfinding::PathfinderService>();
     audioBus_    = std::make_unique<Sensing::Audio::Bus>();
+    visibility_  = std::make_unique<Sensing::Vision::VisibilityMatrix>();
     // Params setting and graph building is done in MainGame.cpp after structures are initialized.
 
 #ifdef AI_DEBUG
@@ -51,6 +58,7 @@ void AISubsystem::addTank(TankId id, Tank* tank, std::unique_ptr<AIDecisionContr
     ctx.gw = std::make_unique<AIServiceGateway>(
         *pathfinding_, ctx.motion.get(), ctx.sensing.get(), ctx.combat.get(), audioBus_.get(), emit
     );
+    ctx.gw->SetMovePlanning(movePlanning_, asyncPlanner_.get());
 
 
     // Install controller
@@ -88,7 +96,11 @@ void AISubsystem::addTank(TankId id, Tank* tank, std::unique_ptr<AIDecisionContr
 
 void AISubsystem::removeTank(const TankId id)
 {
-    agents_.erase(id);
+    const auto it = agents_.find(id);
+    if (it == agents_.end()) return;
+    // Drop the tank's view cone, or paths keep avoiding it
+    if (pathfinding_ && it->second.tank) pathfinding_->RemoveDangerSource(static_cast<std::uint32_t>(it->second.tank->GetID()));
+    agents_.erase(it);
 }
 
 void AISubsystem::setController(const TankId id, std::unique_ptr<AIDecisionController> controller) {
@@ -105,9 +117,31 @@ AIServiceGateway& AISubsystem::gateway(const TankId id)
 
 void AISubsystem::tick(const float dt)
 {
-    // Decay global audio bus
-    if (audioBus_) audioBus_->Decay(dt);
+    // Advance the global audio bus clock, decay the shared flow fields; move the cooperative reservation clock
+    if (audioBus_) audioBus_->Advance(dt);
+    if (pathfinding_) pathfinding_->DecayFlowFields(dt);
+    if (pathfinding_) pathfinding_->AdvanceReservations(dt);
+
+    // Danger layers are refreshed before anyone thinks, so cautious moves see this frame's threats
+    updateDangerSources();
+
+    // Likewise visibility: every Sense_VisibleEnemies of the frame reads this one pass
+    updateVisibility();
+
+    // 0. Async mode: hand over paths that landed since last tick (bounded per tick). Done before
+    //    think so an agent re-issuing MoveTo every frame still receives its previous result.
+    if (asyncPlanner_ && movePlanning_ == AIServiceGateway::MovePlanning::Async) {
+        std::vector<Pathfinding::AsyncPlanner::Completed> landed;
+        asyncPlanner_->Drain(landed, asyncMoveBudget_);
+        for (auto& done : landed) {
+            // Requests are owned by the tank id the gateway submitted with
+            for (auto &a : agents_ | std::views::values) {
+                if (a.gw && a.gw->Self().id == done.owner) { a.gw->ResolveAsyncMove(done.ticket, done.result); break; }
+            }
+        }
+    }
 
+    // 1. Sense and think for every agent; in batched mode MoveTo only records the goal here
     for (auto &a : agents_ | std::views::values) {
         // Build/update SelfState and run sensing
         SelfState self{};
@@ -127,11 +161,31 @@ void AISubsystem::tick(const float dt)
 
         a.gw->SetSelfState(self);
         a.gw->TickSensing(dt);
+        a.gw->TickNav();
 
-        // 2. Let controllers 'think'
         if (a.controller) a.controller->Update(dt);
+    }
 
-        // 3. Execute motion/combat for the frame
+    // 2. Plan all of this frame's move intents as one batch
+    moveQueries_.clear();
+    moveOwners_.clear();
+    for (auto &a : agents_ | std::views::values) {
+        if (const auto& goal = a.gw->PendingMove()) {
+            moveQueries_.push_back({ a.gw->Self().pos, *goal });
+            moveOwners_.push_back(a.gw.get());
+        }
+    }
+    if (!moveQueries_.empty()) {
+        moveResults_.resize(moveQueries_.size());
+        pathfinding_->PlanPaths(moveQueries_, moveResults_);
+        for (size_t i = 0; i < moveOwners_.size(); ++i) {
+            moveOwners_[i]->ResolvePendingMove(moveResults_[i]);
+        }
+    }
+
+    // 3. Execute motion/combat for the frame
+    for (auto &a : agents_ | std::views::values) {
+        const SelfState& self = a.gw->Self();
         a.motion->Tick(dt, self);
         a.combat->Tick(dt, self);
     }
@@ -143,6 +197,91 @@ void AISubsystem::tick(const float dt)
 #endif
 }
 
+void AISubsystem::updateDangerSources()
+{
+    if (!pathfinding_) return;
+
+    // View cones of every tank (player included); the planner skips sources that barely moved
+    for (auto &a : agents_ | std::views::values) {
+        if (!a.tank) continue;
+        const auto key = static_cast<std::uint32_t>(a.tank->GetID());
+        if (a.tank->GetHealth() <= 0) { pathfinding_->RemoveDangerSource(key); continue; }
+
+        const Sensing::SenseConfig& cfg = a.sensing->GetConfig();
+        const float rot = a.tank->GetRotation();
+        Pathfinding::DangerSource cone{};
+        cone.layer     = Pathfinding::CostLayer::Sight;
+        cone.shape     = Pathfinding::DangerSource::Shape::Cone;
+        cone.owner     = static_cast<int>(key);
+        cone.origin    = a.tank->GetPosition();
+        cone.dir       = { std::cos(rot), std::sin(rot) };
+        cone.range     = cfg.viewDistance;
+        cone.halfAngle = cfg.fovDeg * 0.5f * (3.14159265358979323846f / 180.0f);
+        pathfinding_->SetDangerSource(key, cone);
+    }
+
+    // Bullet corridors over the rest of each live bullet's flight, moved along with it every frame (the
+    // planner skips the ones that barely moved) and dropped once the bullet is gone
+    std::vector<std::uint32_t>& live = liveBulletDangerKeys_;
+    live.clear();
+    const float clearance = pathfinding_->GetConfig().tankRadius;
+    for (const Bullet* b : Bullet::GetAllBullets()) {
+        if (!b->IsAlive()) continue;
+        const Play::Vector2D v = b->GetVelocity();
+        const float speed = Geom::len(v);
+        if (speed <= 0.0f) continue;
+        const std::uint32_t key = kBulletDangerKey | (b->GetSerial() & ~kBulletDangerKey);
+        Pathfinding::DangerSource corridor{};
+        corridor.layer     = Pathfinding::CostLayer::Bullets;
+        corridor.shape     = Pathfinding::DangerSource::Shape::Corridor;
+        corridor.owner     = b->GetOwnerId();
+        corridor.origin    = b->GetPosition();
+        corridor.dir       = { v.x / speed, v.y / speed };
+        corridor.range     = b->GetRemainingDistance();
+        corridor.halfWidth = b->GetRadius() + clearance;
+        pathfinding_->SetDangerSource(key, corridor);
+        live.push_back(key);
+    }
+    std::ranges::sort(live);
+    for (const std::uint32_t key : bulletDangerKeys_) {
+        if (!std::ranges::binary_search(live, key)) pathfinding_->RemoveDangerSource(key);
+    }
+    std::swap(bulletDangerKeys_, live);
+}
+
+void AISubsystem::updateVisibility()
+{
+    std::vector<Sensing::Vision::VisibilityMatrix::Observer> observers;
+    std::vector<AgentCtx*> rows;
+    observers.reserve(agents_.size());
+    rows.reserve(agents_.size());
+    for (auto &a : agents_ | std::views::values) {
+        if (!a.tank || !a.sensing) continue;
+        Sensing::Vision::VisibilityMatrix::Observer o{};
+        o.self.pos = a.tank->GetPosition();
+        o.self.rot = a.tank->GetRotation();
+        o.self.id  = static_cast<std::uint32_t>(a.tank->GetID());
+        o.cfg      = a.sensing->GetConfig();
+        observers.push_back(o);
+        rows.push_back(&a);
+    }
+
+    // Live tanks (the player's included) are the targets
+    std::vector<Contact> targets;
+    targets.reserve(Tank::GetAllTanks().size());
+    for (const auto* t : Tank::GetAllTanks()) {
+        if (!t || !t->IsAlive()) continue;
+        Contact c{};
+        c.id   = static_cast<std::uint32_t>(t->GetID());
+        c.pos  = t->GetPosition();
+        c.type = Contact::Type::Tank;
+        targets.push_back(c);
+    }
+
+    visibility_->Build(observers, targets);
+    for (size_t i = 0; i < rows.size(); ++i) rows[i]->sensing->SetFrameVisibility(visibility_.get(), static_cast<int>(i));
+}
+
 void AISubsystem::renderDebugOverlay() {
 #ifdef AI_DEBUG
     if (debugOverlay_) {
@@ -155,6 +294,18 @@ Pathfinding::PathfinderService& AISubsystem::pathfinder() const {
     return *pathfinding_;
 }
 
+void AISubsystem::SetMovePlanning(const AIServiceGateway::MovePlanning mode) {
+    if (mode == AIServiceGateway::MovePlanning::Async && !asyncPlanner_) {
+        asyncPlanner_ = std::make_unique<Pathfinding::AsyncPlanner>(*pathfinding_);
+    }
+    if (asyncPlanner_) asyncPlanner_->CancelAll();
+
+    movePlanning_ = mode;
+    for (auto &a : agents_ | std::views::values) {
+        if (a.gw) a.gw->SetMovePlanning(mode, asyncPlanner_.get());
+    }
+}
+
 void AISubsystem::SetAIEnabled(const bool on) {
     aiEnabled_ = on;
     for (auto &val : agents_ | std::views::values) {
@@ -4,17 +4,19 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
+#include "AI/Gateway/AIServiceGateway.h"
 
 class Tank;
 
-namespace Pathfinding { class PathfinderService; }
+namespace Pathfinding { class PathfinderService; class AsyncPlanner; struct PathQuery; struct PathResult; }
 namespace Motion      { class MotionService;     }
 namespace Combat      { class CombatService;     }
 namespace Sensing     { class SensingService;    }
 namespace Sensing::Audio { class Bus; }
+namespace Sensing::Vision { class VisibilityMatrix; }
 
 namespace AI {
-class AIServiceGateway;
 class AIDecisionController;
 class AIDebugOverlay;
 
@@ -65,20 +67,48 @@ public:
     // Debug-only: audio bus exposure for overlays
     const Sensing::Audio::Bus* Debug_GetAudioBus() const { return audioBus_.get(); }
 
+    // How agents' MoveTo intents are planned (applies to current and future agents)
+    void SetMovePlanning(AIServiceGateway::MovePlanning mode);
+    [[nodiscard]] AIServiceGateway::MovePlanning GetMovePlanning() const { return movePlanning_; }
+
+    // Async mode: max planned paths handed to agents per tick (the rest wait for the next tick)
+    void SetAsyncMoveBudget(size_t perTick) { asyncMoveBudget_ = perTick; }
+
     // Global activation for AI controllers
     void SetAIEnabled(bool on);
     [[nodiscard]] bool GetAIEnabled() const { return aiEnabled_; }
 
 private:
+    // Feeds the planner's danger layers: every live tank's view cone and a corridor ahead of every bullet
+    void updateDangerSources();
+
+    // Perception pass: who sees whom this frame, computed once for all agents and bound to their sensing
+    void updateVisibility();
+
     // Shared
     std::unique_ptr<Pathfinding::PathfinderService> pathfinding_;
     std::unique_ptr<Sensing::Audio::Bus>            audioBus_;
+    std::unique_ptr<Sensing::Vision::VisibilityMatrix> visibility_;
 
     // All agents by TankId
     std::unordered_map<TankId, AgentCtx> agents_;
 
+    // Per-frame batch of deferred MoveTo intents (reused to avoid per-frame allocations)
+    std::vector<Pathfinding::PathQuery>  moveQueries_;
+    std::vector<Pathfinding::PathResult> moveResults_;
+    std::vector<AIServiceGateway*>       moveOwners_;
+
+    AIServiceGateway::MovePlanning movePlanning_{AIServiceGateway::MovePlanning::Batched};
+    std::unique_ptr<Pathfinding::AsyncPlanner> asyncPlanner_; // created when Async is first selected
+    size_t asyncMoveBudget_{8};
+
     bool aiEnabled_{false};
 
+    // Danger source keys: tank cones use the tank id, bullet corridors kBulletDangerKey | bullet serial
+    std::vector<std::uint32_t> bulletDangerKeys_;     // corridors registered last frame, sorted
+    std::vector<std::uint32_t> liveBulletDangerKeys_; // scratch for this frame's
+    static constexpr std::uint32_t kBulletDangerKey = 0x80000000u;
+
 #ifdef AI_DEBUG
     std::unique_ptr<AIDebugOverlay> debugOverlay_;
 #endif
@@ -18,6 +18,9 @@ struct Config {
     float engageAttackRadius{240.0f};
     float engageChaseRadius{300.0f};
 
+    // Micro-patrol goals are picked within this distance of the tank
+    float lowHpMicroPatrolRadius{200.0f};
+
     // Health threshold for low HP branch
     int lowHpThreshold{1};
 
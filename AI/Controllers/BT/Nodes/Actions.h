@@ -121,7 +121,7 @@ public:
             if (auto lk = gw.Sense_LastKnown(*bb.targetId)) { goal_ = lk->pos; }
         }
         if (!goal_ && bb.lastKnown) goal_ = bb.lastKnown;
-        if (goal_) { gw.MoveTo(*goal_); active_ = true; }
+        if (goal_) { gw.MoveTo(*goal_, AIServiceGateway::MoveStyle::Cautious); active_ = true; }
     }
     Status Tick(float /*dt*/, Blackboard& bb, AIServiceGateway& gw) override {
         if (!goal_) { Debug_SetLastStatus_(Status::Failure); return Status::Failure; }
@@ -172,7 +172,7 @@ public:
 
         if (!inAttack) {
             if (aiming_) { gw.CancelAim(); aiming_ = false; }
-            gw.MoveTo(targetPos); chasing_ = true;
+            gw.Pursue(targetPos); chasing_ = true;
         } else {
             if (chasing_) { gw.CancelMove(); chasing_ = false; }
 
@@ -215,9 +215,9 @@ private:
 class MicroPatrolAction final : public Node {
 public:
     explicit MicroPatrolAction(const Config& cfg) : cfg_(cfg) {}
-    void OnEnter(Blackboard& /*bb*/, AIServiceGateway& gw) override {
+    void OnEnter(Blackboard& bb, AIServiceGateway& gw) override {
         timer_ = 0.0f;
-        gw.MoveTo(gw.Nav_GetRandomReachable({}));
+        gw.MoveTo(gw.Nav_GetRandomReachable({ bb.self.pos, cfg_.lowHpMicroPatrolRadius }));
         active_ = true;
     }
     Status Tick(float dt, Blackboard& /*bb*/, AIServiceGateway& gw) override {
@@ -246,7 +246,7 @@ public:
             if (!threatPos_) { Debug_SetLastStatus_(Status::Failure); return Status::Failure; }
             fleePoint_ = AI::Behaviors::FindFleeLocation(bb.self.pos, threatPos_, gw);
             if (Geom::dist(fleePoint_, bb.self.pos) <= 1.0f) { bb.lastKnown.reset(); Debug_SetLastStatus_(Status::Failure); return Status::Failure; }
-            gw.MoveTo(fleePoint_); active_ = true; Debug_SetLastStatus_(Status::Running); return Status::Running;
+            gw.MoveTo(fleePoint_, AIServiceGateway::MoveStyle::Cautious); active_ = true; Debug_SetLastStatus_(Status::Running); return Status::Running;
         }
         const auto st = gw.GetMotionStatus();
         if (st == Motion::FollowCommand::Status::Following) { Debug_SetLastStatus_(Status::Running); return Status::Running; }
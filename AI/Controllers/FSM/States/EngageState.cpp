@@ -63,7 +63,7 @@ void EngageState::Tick(float dt) {
 
   if (mode_ == Mode::Chase) {
     ctrl_.GW().CancelAim();
-    ctrl_.GW().MoveTo(r->pos);
+    ctrl_.GW().Pursue(r->pos);
     return;
   }
 
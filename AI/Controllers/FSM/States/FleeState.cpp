@@ -15,7 +15,7 @@ void FleeState::OnEnter() {
     ctrl_.GetLastKnown(),
     ctrl_.GW()
   );
-  ctrl_.GW().MoveTo(fleePoint);
+  ctrl_.GW().MoveTo(fleePoint, AIServiceGateway::MoveStyle::Cautious);
 
   timeSinceDamage_ = 0.0f; // Reset timer on entering flee
 }
@@ -60,7 +60,7 @@ void FleeState::OnThreatUpdate() {
     ctrl_.GetLastKnown(),
     ctrl_.GW()
   );
-  ctrl_.GW().MoveTo(fleePoint);
+  ctrl_.GW().MoveTo(fleePoint, AIServiceGateway::MoveStyle::Cautious);
 }
 
 } // namespace AI
@@ -12,7 +12,9 @@ void PatrolState::OnEnter() {
 void PatrolState::Tick(const float dt) {
   (void)dt;
   if (!ctrl_.IsActive() || ctrl_.Self().hp <= 0) { ctrl_.ChangeState(FSMState::Idle); return; }
-  if (ctrl_.GW().GetMotionStatus() != Motion::FollowCommand::Status::Following) {
+  // Don't re-issue while the previous patrol leg is still being planned
+  const auto status = ctrl_.GW().GetMotionStatus();
+  if (status != Motion::FollowCommand::Status::Following && status != Motion::FollowCommand::Status::Pending) {
     Behaviors::PatrolToRandomPoint(ctrl_.GW());
   }
 }
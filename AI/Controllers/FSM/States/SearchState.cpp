@@ -16,7 +16,7 @@ void SearchState::OnEnter() {
   if (!goal_) goal_ = ctrl_.GetLastKnown();
 
   if (goal_) {
-    ctrl_.GW().MoveTo(*goal_);
+    ctrl_.GW().MoveTo(*goal_, AIServiceGateway::MoveStyle::Cautious);
   } else {
     ctrl_.GW().ReleaseFire();
     ctrl_.ChangeState(FSMState::LookAround);
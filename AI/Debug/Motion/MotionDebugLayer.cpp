@@ -38,6 +38,7 @@ void MotionDebugLayer::render(const AISubsystem& sys) const {
       case Motion::FollowCommand::Status::Following: statusStr = "Following"; col = Play::cBlue; break;
       case Motion::FollowCommand::Status::Arrived:   statusStr = "Arrived";   col = Play::cGreen; break;
       case Motion::FollowCommand::Status::Blocked:   statusStr = "Blocked";   col = Play::cRed;   break;
+      case Motion::FollowCommand::Status::Pending:   statusStr = "Pending";   col = Play::cYellow; break;
       default: break;
     }
 
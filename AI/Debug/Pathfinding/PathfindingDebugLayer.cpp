@@ -3,6 +3,7 @@
 #include "AISubsystem.h"
 #include "Globals.h"
 #include "Pathfinding/Pathfinding.h"
+#include "Pathfinding/AStar/SearchContext.h"
 
 namespace AI {
 
@@ -125,15 +126,19 @@ void PathfindingDebugLayer::draw_graph(const Pathfinding::PathfinderService& pat
 
   // Draw edges
   for (int i = 0; i < g.size(); ++i) {
-    const auto &[startPos, startEdges] = g.nodes()[i];
-    for (const auto &[to, cost] : startEdges) {
-      const auto &[endPos, endEdges] = g.nodes()[to];
-      Play::DrawLine(startPos, endPos, Play::cCyan);
+    const Play::Vector2D startPos = g.pos(i);
+    for (int e = g.edgeBegin(i); e < g.edgeEnd(i); ++e) {
+      const bool closed = g.edgeCost(e) == Pathfinding::kBlockedCost;
+      Play::DrawLine(startPos, g.pos(g.edgeTarget(e)), closed ? Play::cRed : Play::cCyan);
     }
   }
+  // Dynamic obstacles (inflated) that closed the red edges
+  for (const auto& r : pathfinder.GetDynamicObstacles()) {
+    Play::DrawRect({ r.minx, r.miny }, { r.maxx, r.maxy }, Play::cOrange);
+  }
   // Draw nodes and their numeric labels on top of edges (or below)
   for (int i = 0; i < g.size(); ++i) {
-    const auto &[pos, edges] = g.nodes()[i];
+    const Play::Vector2D pos = g.pos(i);
     Play::DrawCircle(pos, kNodeRadius, Play::cYellow);
     char label[32]{};
     std::snprintf(label, sizeof(label), "%d", i);
@@ -178,10 +183,14 @@ void PathfindingDebugLayer::draw_path(const Pathfinding::PathfinderService& path
 void PathfindingDebugLayer::plan_and_store_path(const Pathfinding::PathfinderService& pathfinder) {
 
   if (startPos_.has_value() && goalPos_.has_value()) {
-    if (const auto result = pathfinder.PlanPath(startPos_.value(), goalPos_.value()); result.has_value()){
-      pathPolyline_ = result->polyline;
-      pathCost_ = result->cost;
-      return;
+    Pathfinding::SearchContext ctx;
+    if (auto result = pathfinder.PlanPath(startPos_.value(), goalPos_.value(), ctx); result.has_value()){
+      // Draw hierarchical plans in full
+      if (pathfinder.RefineRoute(result->route, result->polyline, -1, ctx)) {
+        pathPolyline_ = std::move(result->polyline);
+        pathCost_ = result->cost;
+        return;
+      }
     }
 
     pathPolyline_.clear();
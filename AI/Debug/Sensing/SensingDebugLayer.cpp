@@ -78,26 +78,25 @@ void SensingDebugLayer::render(const AISubsystem& sys) const {
       std::unordered_set<std::uint32_t> visSet; visSet.reserve(visibles.size());
       for (const auto& c : visibles) visSet.insert(c.id);
 
-      for (const auto &otherId : sys.getAgents() | std::views::keys) {
-        if (otherId == id) continue;
-        if (visSet.contains(static_cast<std::uint32_t>(otherId))) continue;
-
-        if (auto info = sens.Debug_LastKnownInfo((otherId))) {
-          const float alpha01 = clamp01(1.0f - (info->ageSec / std::max(0.001f, cfg.memoryTTL)));
-          const unsigned char a = u8(30.0f + alpha01 * 170.0f);
-          const bool isHearing = (info->source == Sensing::MemorySource::Hearing);
-
-          // Cyan for vision, Purple for hearing
-          Play::Colour dotCol = isHearing ? Play::Colour{ 160, 64, 255, a }
-                                           : Play::Colour{   0, 200, 255, a };
-
-          Play::DrawCircle(info->pos, 4, dotCol);
-
-          // Label with age seconds
-          char label[48];
-          std::snprintf(label, sizeof(label), "Last known (%.1fs)", info->ageSec);
-          Play::DrawDebugText({ info->pos.x, info->pos.y + 14.0f }, label, 12, Play::cWhite);
-        }
+      sens.Debug_LastKnownAll(lastKnown_);
+      for (const auto& info : lastKnown_) {
+        if (info.id == static_cast<std::uint32_t>(id)) continue;
+        if (visSet.contains(info.id)) continue;
+
+        const float alpha01 = clamp01(1.0f - (info.ageSec / std::max(0.001f, cfg.memoryTTL)));
+        const unsigned char a = u8(30.0f + alpha01 * 170.0f);
+        const bool isHearing = (info.source == Sensing::MemorySource::Hearing);
+
+        // Cyan for vision, Purple for hearing
+        Play::Colour dotCol = isHearing ? Play::Colour{ 160, 64, 255, a }
+                                         : Play::Colour{   0, 200, 255, a };
+
+        Play::DrawCircle(info.pos, 4, dotCol);
+
+        // Label with age seconds
+        char label[48];
+        std::snprintf(label, sizeof(label), "Last known (%.1fs)", info.ageSec);
+        Play::DrawDebugText({ info.pos.x, info.pos.y + 14.0f }, label, 12, Play::cWhite);
       }
     }
 
@@ -113,27 +112,25 @@ void SensingDebugLayer::render(const AISubsystem& sys) const {
   if (showAudio_) {
     const auto* bus = sys.Debug_GetAudioBus();
     if (bus) {
-      const auto events = bus->Debug_All();
       constexpr float ttl = 1.0f; // ~1s window
-      for (const auto &ev : events) {
-        const float alpha01 = std::clamp(1.0f - (ev.ageSec / ttl), 0.0f, 1.0f);
+      bus->ForEach([&](const Sensing::Audio::BusEvent& ev) {
+        const float alpha01 = std::clamp(1.0f - (bus->AgeOf(ev) / ttl), 0.0f, 1.0f);
         const unsigned char a = u8(30.0f + alpha01 * 160.0f);
         Play::Colour col = (ev.kind == AI::SoundHeardEvent::Kind::Bullet)
                            ? Play::Colour{255, 64, 64, a}
                            : Play::Colour{  0,255,  0, a};
         Play::DrawCircle(ev.pos, static_cast<int>(ev.radius), col);
-      }
+      });
       // Per-agent hearing links (dashed)
       for (const auto &agent : sys.getAgents() | std::views::values) {
         if (!agent.tank || !agent.gw) continue;
         const std::uint32_t selfId = static_cast<std::uint32_t>(agent.tank->GetID());
         const Play::Vector2D ear = agent.tank->GetPosition();
-        const auto audible = bus->QueryInRadius(ear);
-        for (const auto &ev : audible) {
-          if (ev.sourceId == selfId) continue; // skip self
+        bus->ForEachAudible(ear, [&](const Sensing::Audio::BusEvent& ev) {
+          if (ev.sourceId == selfId) return; // skip self
           const float dx = ev.pos.x - ear.x, dy = ev.pos.y - ear.y;
           const float len = std::sqrt(dx*dx + dy*dy);
-          if (len <= 1e-3f) continue;
+          if (len <= 1e-3f) return;
           const float ux = dx / len, uy = dy / len;
           float t = 0.0f; bool draw = true; constexpr int dash = 8, gap = 6;
           while (t < len) {
@@ -145,7 +142,7 @@ void SensingDebugLayer::render(const AISubsystem& sys) const {
             }
             t += draw ? seg : gap; draw = !draw;
           }
-        }
+        });
       }
     }
   }
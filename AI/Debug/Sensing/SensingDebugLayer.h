@@ -3,6 +3,7 @@
 /// @brief Debug layer for AI sensing system
 
 #include "Debug/DebugLayer.h"
+#include "Services/Sensing/Types.h"
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@ private:
   // Scratch buffers to reduce per-frame allocations
   mutable std::string hudLine_;
   mutable std::vector<std::string> hudLines_;
+  mutable std::vector<Sensing::LastKnownInfo> lastKnown_;
 };
 
 } // namespace AI
@@ -3,6 +3,7 @@
 #include "Combat/CombatService.h"
 #include "Play.h"
 #include "Services/Pathfinding/Pathfinding.h"
+#include "Services/Pathfinding/Async/AsyncPlanner.h"
 #include "Services/Motion/Motion.h"
 #include "Services/Sensing/Sensing.h"
 #include "Services/Sensing/Audio/Bus.h"
@@ -33,12 +34,14 @@ namespace AI
             // Arrived
             [this](const Play::Vector2D& g)
             {
+                DropCooperativeMove_(); // the plan is done, free its reservations for the others
                 if (subs_.onArrived) subs_.onArrived(ArrivedEvent{ g });
                 debugCounts_.arrived++;
             },
             // Blocked
             [this](const Play::Vector2D& at)
             {
+                DropCooperativeMove_();
                 if (subs_.onBlocked) subs_.onBlocked(BlockedEvent{ at });
                 debugCounts_.blocked++;
             }
@@ -103,21 +106,20 @@ namespace AI
         // Always scan audio for counting, emit onSound only if subscribed
         if (audioBus_)
         {
-            const auto nearby = audioBus_->QueryInRadius(self_.pos);
-            for (const auto &ev : nearby) {
-                if (ev.sourceId == self_.id) continue;
+            audioBus_->ForEachAudible(self_.pos, [&](const Sensing::Audio::BusEvent& ev) {
+                if (ev.sourceId == self_.id) return;
                 const std::uint64_t key = (static_cast<std::uint64_t>(ev.sourceId) << 32) | static_cast<std::uint64_t>(ev.kind);
 
                 // Process each bus event at most once per listener by sequence id
                 std::uint32_t &lastSeq = lastProcessedSeq_[key];
-                if (ev.seq <= lastSeq) continue; // already processed this event instance
+                if (ev.seq <= lastSeq) return; // already processed this event instance
                 lastSeq = ev.seq;
 
                 // Time-based debounce (secondary guard)
                 float &last = soundDebounceTimers_[key];
                 const float minInterval = (ev.kind == SoundHeardEvent::Kind::Bullet) ? 1.0f : 0.5f;
                 const auto now = static_cast<float>(::GetTime());
-                if ((now - last) < minInterval) continue;
+                if ((now - last) < minInterval) return;
                 last = now;
 
                 if (!prevVisibleIds_.contains(ev.sourceId)) {
@@ -128,7 +130,7 @@ namespace AI
                     subs_.onSound(e);
                 }
                 debugCounts_.sounds++;
-            }
+            });
         }
     }
 
@@ -157,16 +159,19 @@ namespace AI
 
     Path AIServiceGateway::Nav_FindPath(const Play::Vector2D& start,const Play::Vector2D& goal) const
     {
-        if (auto result = pf_.PlanPath(start, goal))
+        if (auto result = pf_.PlanPath(start, goal, searchCtx_))
         {
-            return result->polyline;
+            if (pf_.RefineRoute(result->route, result->polyline, -1, searchCtx_)) return std::move(result->polyline);
         }
         return {};
     }
 
     Play::Vector2D AIServiceGateway::Nav_GetRandomReachable(const AI::NavConstraints& c) const
     {
-        return pf_.GetRandomReachablePoint();
+        if (c.radius <= 0.0f) return pf_.GetRandomReachablePoint();
+        // Nothing walkable and reachable within the radius -> stay around the center
+        if (const auto p = pf_.GetRandomReachablePoint(c.center, c.radius)) return *p;
+        return pf_.ProjectToWalkable(c.center);
     }
 
     // ---- Sensing: helpers ----
@@ -190,6 +195,8 @@ namespace AI
     // ---- Sensing ----
     std::vector<Contact> AIServiceGateway::Sense_VisibleEnemies() const {
         if (!sensing_) return {};
+        // Read this frame's shared visibility when the subsystem computed it; test FOV/LOS directly otherwise
+        if (sensing_->HasFrameVisibility()) return sensing_->VisibleNow().visible;
         const auto candidates = BuildEnemyCandidates_(self_);
         const auto [visible] = sensing_->VisibleNow(candidates);
         return visible;
@@ -206,26 +213,174 @@ namespace AI
     }
 
     // ---- Intents ----
-    void AIServiceGateway::MoveTo(const Play::Vector2D& goal) {
+    void AIServiceGateway::MoveTo(const Play::Vector2D& goal, const MoveStyle style) {
+        pursue_.reset();
+        IssueMove_(goal, style);
+    }
+
+    static bool SameAttachment_(const Pathfinding::GraphAnchor& x, const Pathfinding::GraphAnchor& y)
+    {
+        return x.node == y.node && x.a == y.a && x.b == y.b;
+    }
+
+    void AIServiceGateway::Pursue(const Play::Vector2D& goal) {
+        if (!motion_) { MoveTo(goal); return; }
+
+        if (pursue_ && Geom::dist(goal, pursue_->planGoal) <= kPursueReplanDrift)
+        {
+            // A plan for a nearby goal is still on its way
+            if (pendingMove_ || pendingTicket_ != 0) return;
+
+            // Edits below assume the followed path ends at the goal (not at a pending route)
+            const Path& path = motion_->GetPath();
+            const size_t n = path.size();
+            if (n >= 2 && route_.empty() && motion_->GetStatus() == Motion::FollowCommand::Status::Following)
+            {
+                const Pathfinding::GraphAnchor anchor = pf_.FindAttachment(goal);
+                const bool sameAttachment = SameAttachment_(anchor, pursue_->anchor);
+
+                // Cooperative plan -> editing the path would leave its reservations on the old one, so keep
+                // it while the goal stays on the same attachment and re-plan it cooperatively otherwise
+                if (cooperativeGoal_ && sameAttachment) return;
+
+                // Case 1: Same attachment -> the path only differs in its end point
+                if (sameAttachment)
+                {
+                    if (Geom::dist2(anchor.pos, path.back()) > 1e-4f)
+                    {
+                        Path moved = path;
+                        moved.back() = anchor.pos;
+                        motion_->ReplacePath(moved);
+                        navRepair_.Reset(moved.back(), pf_.GetNavVersion());
+                    }
+                    return;
+                }
+
+                // Case 2: Attachment changed -> replan only from the last waypoint before the goal,
+                // unless we are already past it (then the whole path is effectively the tail)
+                const Play::Vector2D& from = path[n - 2];
+                if (!cooperativeGoal_ && Geom::dist(self_.pos, path.back()) > Geom::dist(from, path.back()))
+                {
+                    if (const Path tail = Nav_FindPath(from, goal); !tail.empty())
+                    {
+                        Path repaired(path.begin(), path.end() - 2);
+                        repaired.insert(repaired.end(), tail.begin(), tail.end());
+                        motion_->ReplacePath(repaired);
+                        navRepair_.Reset(repaired.back(), pf_.GetNavVersion());
+                        pursue_->anchor = anchor;
+                        return;
+                    }
+                }
+            }
+        }
+
+        // Case 3: Drifted too far, not following, cooperative, or repair failed -> full replan
+        pursue_ = PursueState{ goal, pf_.FindAttachment(goal) };
+        IssueMove_(goal);
+    }
+
+    void AIServiceGateway::IssueMove_(const Play::Vector2D& goal, const MoveStyle style) {
         if (!motion_)
         {
             if (subs_.onBlocked) subs_.onBlocked(BlockedEvent{ self_.pos });
             return;
         }
 
-        // Case 1: Start ~ Goal (arrive shortcut)
+        // Case 1: Start ~ Goal (arrive shortcut) -> end the current move as an arrival would
         const float tol = std::max(10.0f, 0.5f * self_.radius);
         if (Geom::dist(self_.pos, goal) <= tol)
         {
+            DropPendingMove_();
+            DropCooperativeMove_();
+            navRepair_.Clear();
+            route_.clear();
+            motion_->CancelFollow();
             if (subs_.onArrived) subs_.onArrived(ArrivedEvent{ goal });
             return;
         }
 
-        // Case 2: Plan a path
-        const Path path = Nav_FindPath(self_.pos, goal);
+        // Any new plan replaces a cooperative one (and frees its reservations)
+        DropCooperativeMove_();
+
+        // Case 2: Cautious -> the danger layers are main-thread state, so plan now whatever the mode
+        if (style == MoveStyle::Cautious)
+        {
+            DropPendingMove_();
+            Pathfinding::TacticalQuery query{};
+            query.excludeOwner = static_cast<int>(self_.id);
+            auto result = pf_.PlanTacticalPath(self_.pos, goal, query, searchCtx_);
+            FollowPlannedPath_(result ? *result : Pathfinding::PathResult{});
+            return;
+        }
+
+        // Case 2a: Cooperative -> so are the reservations; plans are sequenced in the order agents ask
+        if (pf_.CooperativeEnabled())
+        {
+            DropPendingMove_();
+            auto result = pf_.PlanCooperativePath(static_cast<int>(self_.id), self_.pos, goal, searchCtx_);
+            FollowPlannedPath_(result ? *result : Pathfinding::PathResult{});
+            if (result) cooperativeGoal_ = goal;
+            return;
+        }
+
+        // Case 2b: Deferred -> the subsystem plans it with the rest of the frame's moves
+        if (movePlanning_ == MovePlanning::Batched)
+        {
+            pendingMove_ = goal;
+            return;
+        }
+
+        // Case 2c: Async -> planned in the background, supersedes any request still in flight
+        if (movePlanning_ == MovePlanning::Async && asyncPlanner_)
+        {
+            pendingTicket_ = asyncPlanner_->Submit(self_.id, { self_.pos, goal });
+            return;
+        }
+
+        // Case 3: Plan a path now
+        auto result = pf_.PlanPath(self_.pos, goal, searchCtx_);
+        FollowPlannedPath_(result ? *result : Pathfinding::PathResult{});
+    }
+
+    void AIServiceGateway::ResolvePendingMove(const Pathfinding::PathResult& result) {
+        // Clear first: a Blocked handler may issue a new MoveTo, which is then resolved next frame
+        if (!pendingMove_) return;
+        pendingMove_.reset();
+        FollowPlannedPath_(result);
+    }
+
+    void AIServiceGateway::ResolveAsyncMove(const std::uint64_t ticket, const Pathfinding::PathResult& result) {
+        if (ticket != pendingTicket_) return; // superseded or cancelled meanwhile
+        pendingTicket_ = 0;
+        FollowPlannedPath_(result);
+    }
+
+    void AIServiceGateway::SetMovePlanning(const MovePlanning mode, Pathfinding::AsyncPlanner* asyncPlanner) {
+        DropPendingMove_();
+        movePlanning_ = mode;
+        asyncPlanner_ = asyncPlanner;
+    }
+
+    void AIServiceGateway::DropCooperativeMove_() {
+        if (!cooperativeGoal_) return;
+        cooperativeGoal_.reset();
+        pf_.ReleaseReservations(static_cast<int>(self_.id));
+    }
+
+    void AIServiceGateway::DropPendingMove_() {
+        pendingMove_.reset();
+        if (pendingTicket_ != 0)
+        {
+            if (asyncPlanner_) asyncPlanner_->Cancel(self_.id);
+            pendingTicket_ = 0;
+        }
+    }
+
+    void AIServiceGateway::FollowPlannedPath_(const Pathfinding::PathResult& result) {
+        const Path& path = result.polyline;
         if (path.empty())
         {
-            // Case 2b: Planner failed (no route)
+            // Planner failed (no route)
             if (subs_.onBlocked) subs_.onBlocked(BlockedEvent{ self_.pos });
             return;
         }
@@ -239,8 +394,61 @@ namespace AI
             motion_->SetProfile(prof);
         }
 
-        // Case 3: Valid path -> follow
-        motion_->FollowPath(path);
+        // Valid path -> follow (waiting where a cooperative plan says so)
+        motion_->FollowPath(path, result.departures);
+        route_ = result.route;
+        navRepair_.Reset(route_.empty() ? path.back() : route_.goal, pf_.GetNavVersion());
+    }
+
+    void AIServiceGateway::TickNav() {
+        if (!motion_ || !navRepair_.active) return;
+        if (motion_->GetStatus() != Motion::FollowCommand::Status::Following) return;
+
+        Pathfinding::PathResult repaired;
+        switch (pf_.RepairPath(navRepair_, self_.pos, motion_->GetPath(), repaired))
+        {
+            case Pathfinding::PathfinderService::RepairOutcome::Repaired:
+                // Repairs run all the way to the goal, so any pending route is superseded
+                motion_->ReplacePath(repaired.polyline);
+                route_.clear();
+                return;
+            case Pathfinding::PathfinderService::RepairOutcome::NoPath:
+                // Goal cut off by a dynamic obstacle
+                navRepair_.Clear();
+                route_.clear();
+                pursue_.reset();
+                DropCooperativeMove_();
+                motion_->CancelFollow();
+                if (subs_.onBlocked) subs_.onBlocked(BlockedEvent{ self_.pos });
+                debugCounts_.blocked++;
+                return;
+            case Pathfinding::PathfinderService::RepairOutcome::Unchanged:
+                break;
+        }
+
+        // Cooperative plan: renew it before the reservations run out
+        if (cooperativeGoal_ && motion_->GetFollowTime() >= 0.5f * pf_.GetConfig().cooperativeWindow)
+        {
+            IssueMove_(*cooperativeGoal_);
+            return;
+        }
+
+        // Hierarchical plan: refine the next hops before the tank runs out of waypoints
+        if (route_.empty()) return;
+        const Path& path = motion_->GetPath();
+        const auto& config = pf_.GetConfig();
+        if (!path.empty() && Geom::dist(self_.pos, path.back()) > std::max(kRouteRefineAhead, config.hierarchyClusterSize)) return;
+
+        Path extended = path;
+        if (pf_.RefineRoute(route_, extended, config.hierarchyEagerHops, searchCtx_))
+        {
+            motion_->ReplacePath(extended);
+            return;
+        }
+        // A hop became impassable since planning -> plan again from here
+        const Play::Vector2D goal = route_.goal;
+        route_.clear();
+        IssueMove_(goal);
     }
 
     void AIServiceGateway::MoveToRandom(const NavConstraints& c) {
@@ -249,10 +457,20 @@ namespace AI
     }
 
     void AIServiceGateway::CancelMove() {
+        DropPendingMove_();
+        DropCooperativeMove_();
+        pursue_.reset();
+        navRepair_.Clear();
+        route_.clear();
         if (motion_) motion_->CancelFollow();
     }
 
     void AIServiceGateway::Stop() {
+        DropPendingMove_();
+        DropCooperativeMove_();
+        pursue_.reset();
+        navRepair_.Clear();
+        route_.clear();
         if (motion_)
         {
             motion_->CancelFollow();
@@ -279,6 +497,7 @@ namespace AI
     }
 
     Motion::FollowCommand::Status AIServiceGateway::GetMotionStatus() const {
+        if (pendingMove_ || pendingTicket_ != 0) return Motion::FollowCommand::Status::Pending;
         return motion_ ? motion_->GetStatus() : Motion::FollowCommand::Status::Idle;
     }
 
@@ -10,8 +10,12 @@
 #include <unordered_map>
 #include <cstdint>
 #include "Services/Motion/Types.h"
+#include "Services/Pathfinding/AStar/SearchContext.h"
+#include "Services/Pathfinding/Graph/GraphOverlay.h"
+#include "Services/Pathfinding/Incremental/PathRepair.h"
+#include "Services/Pathfinding/Hierarchy/PendingRoute.h"
 
-namespace Pathfinding { class PathfinderService; }
+namespace Pathfinding { class PathfinderService; class AsyncPlanner; struct PathResult; }
 namespace Motion      { class MotionService;     }
 namespace Sensing     { class SensingService;    }
 namespace Combat      { class CombatService;     }
@@ -54,10 +58,14 @@ public:
                               bool emitSounds = false);
 
     // Reset transient per-agent state
-    void Reset() { soundDebounceTimers_.clear(); prevVisibleIds_.clear(); debugCounts_ = {}; }
+    void Reset() { soundDebounceTimers_.clear(); prevVisibleIds_.clear(); debugCounts_ = {}; DropPendingMove_(); pursue_.reset(); navRepair_.Clear(); route_.clear(); DropCooperativeMove_(); }
 
     // ---- Per frame ----
     void TickSensing(float dt);
+    // Repairs the followed path when dynamic obstacles changed the nav graph; raises Blocked if
+    // the goal became unreachable. Also extends a hierarchical plan as the tank nears the end of
+    // its refined part, and renews cooperative plans every half window. Call after SetSelfState.
+    void TickNav();
 
     // ---- Queries (Nav) ----
     [[nodiscard]] ProjectionResult Nav_Project(const Play::Vector2D& p) const;
@@ -70,7 +78,15 @@ public:
     [[nodiscard]] std::optional<Contact> Sense_LastKnown(std::uint32_t id) const;
 
     // ---- Intents ----
-    void MoveTo(const Play::Vector2D& goal);
+    // Direct:   shortest path (planned per MovePlanning).
+    // Cautious: path that keeps out of enemy view cones and bullet corridors where the detour is
+    //           worth it (PlanTacticalPath, ignoring this tank's own cone); always planned on the spot.
+    enum class MoveStyle { Direct, Cautious };
+    void MoveTo(const Play::Vector2D& goal, MoveStyle style = MoveStyle::Direct);
+    // Chase a moving goal; meant to be called every frame. Keeps the current path while the goal
+    // stays on the same graph attachment (only the end point moves), repairs just the tail when the
+    // attachment changes, and replans fully once the goal drifts past kPursueReplanDrift.
+    void Pursue(const Play::Vector2D& goal);
     void MoveToRandom(const NavConstraints& c);
     void CancelMove();
     void Stop();
@@ -95,6 +111,20 @@ public:
     [[nodiscard]] bool  Combat_IsCharging() const;
     [[nodiscard]] float Combat_ChargeAccum() const;
 
+    // ---- Move planning (driven by AISubsystem) ----
+    // Immediate: MoveTo plans on the spot.
+    // Batched:   MoveTo records the goal; the subsystem plans every recorded goal of the frame in
+    //            one batch and hands each path back through ResolvePendingMove.
+    // Async:     MoveTo submits to the background planner; the subsystem hands landed results back
+    //            through ResolveAsyncMove. The current path keeps being followed until then.
+    // While a move is outstanding GetMotionStatus() reports Pending.
+    enum class MovePlanning { Immediate, Batched, Async };
+    void SetMovePlanning(MovePlanning mode, Pathfinding::AsyncPlanner* asyncPlanner = nullptr);
+
+    [[nodiscard]] const std::optional<Play::Vector2D>& PendingMove() const { return pendingMove_; }
+    void ResolvePendingMove(const Pathfinding::PathResult& result);
+    void ResolveAsyncMove(std::uint64_t ticket, const Pathfinding::PathResult& result);
+
     // ---- Context ----
     void        SetSelfState(const SelfState& s); // controller sets each tick
     [[nodiscard]] const SelfState& Self() const { return self_; }
@@ -113,6 +143,10 @@ public:
 private:
     void BindMotionCallbacks_();
     void BindSoundEmitter_() const;
+    void FollowPlannedPath_(const Pathfinding::PathResult& result);
+    void DropPendingMove_();
+    void IssueMove_(const Play::Vector2D& goal, MoveStyle style = MoveStyle::Direct);
+    void DropCooperativeMove_();
 
     Pathfinding::PathfinderService& pf_;
     Motion::MotionService*           motion_{nullptr};
@@ -131,6 +165,34 @@ private:
 
     // Debug tallies and last event times
     DebugEventCounts debugCounts_{};
+
+    // Per-agent A* scratch reused by every path query this agent makes
+    mutable Pathfinding::SearchContext searchCtx_{};
+
+    // Outstanding move (batched goal or async ticket), cleared when resolved or cancelled
+    MovePlanning movePlanning_{MovePlanning::Immediate};
+    Pathfinding::AsyncPlanner* asyncPlanner_{nullptr};
+    std::optional<Play::Vector2D> pendingMove_{};
+    std::uint64_t pendingTicket_{0};
+
+    // Pursue state: goal of the last full plan and where the current path's goal attaches
+    struct PursueState {
+        Play::Vector2D planGoal{};
+        Pathfinding::GraphAnchor anchor{};
+    };
+    std::optional<PursueState> pursue_{};
+    static constexpr float kPursueReplanDrift = 64.0f; // px from planGoal before a full replan
+
+    // Incremental repair of the followed path (reset whenever a new path starts being followed)
+    Pathfinding::PathRepairState navRepair_{};
+
+    // Unrefined tail of a hierarchical plan; refined a few hops at a time once the tank is within
+    // kRouteRefineAhead (or one cluster) of the end of the followed path
+    Pathfinding::PendingRoute route_{};
+    static constexpr float kRouteRefineAhead = 160.0f;
+
+    // Goal of the cooperative plan being followed (replanned every half window to keep reservations ahead)
+    std::optional<Play::Vector2D> cooperativeGoal_{};
  };
 
 
@@ -0,0 +1,85 @@
+#include "Arena.h"
+#include "Obstacles/Structures.h"
+#include "Helper/LineOfSight.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+// The obstacle list the pathfinder reads, and its version. Obstacles/Structures.cpp also draws it
+// through the Play layer, which the benchmark does not link.
+std::vector<Structure> Structures;
+std::uint32_t StructuresVersion = 0;
+
+namespace Bench {
+
+// Same body and margins as MainGame
+static constexpr float kTankRadius = 32.0f;
+static constexpr float kSafetyMargin = 6.0f;
+static constexpr float kTurnRadius = 28.0f;
+
+// Space kept between boxes (px)
+static constexpr float kBoxGap = 8.0f;
+
+// Boxes that stop fitting after this many tries per placed box end the fill early
+static constexpr int kPlacementTries = 256;
+
+Pathfinding::PathfindingConfig GenerateArena(const ArenaSpec& spec)
+{
+    const float clearance = kTankRadius + kSafetyMargin;
+    const float inner = 2.0f * clearance; // a tank fits between a box and the wall
+
+    Structures.clear();
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<float> side(spec.minBox, spec.maxBox);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const float target = std::clamp(spec.density, 0.0f, 0.9f) * spec.width * spec.height;
+    float covered = 0.0f;
+    int misses = 0;
+    while (covered < target && misses < kPlacementTries) {
+        const float w = side(rng), h = side(rng);
+        const float spanX = spec.width - 2.0f * inner - w, spanY = spec.height - 2.0f * inner - h;
+        if (spanX <= 0.0f || spanY <= 0.0f) break;
+        const Play::Point2D pos{ inner + unit(rng) * spanX, inner + unit(rng) * spanY };
+
+        const bool overlaps = std::ranges::any_of(Structures, [&](const Structure& s) {
+            return pos.x < s.BottomLeft.x + s.Size.x + kBoxGap && s.BottomLeft.x < pos.x + w + kBoxGap &&
+                   pos.y < s.BottomLeft.y + s.Size.y + kBoxGap && s.BottomLeft.y < pos.y + h + kBoxGap;
+        });
+        if (overlaps) { ++misses; continue; }
+
+        Structures.push_back({ pos, { w, h } });
+        covered += w * h;
+        misses = 0;
+    }
+    Structures.push_back({ { 0.0f, 0.0f }, { spec.width, spec.height } });
+    ++StructuresVersion;
+    LOSHelper::RebuildStructureTable();
+
+    Pathfinding::PathfindingConfig params;
+    params.playableOrigin = Structures.back().BottomLeft;
+    params.playableSize = Structures.back().Size;
+    params.tankRadius = kTankRadius;
+    params.safetyMargin = kSafetyMargin;
+    params.outerInset = clearance;
+    params.turnRadius = kTurnRadius;
+    return params;
+}
+
+float ArenaCoverage()
+{
+    if (Structures.empty()) return 0.0f;
+    float covered = 0.0f;
+    for (size_t i = 0; i + 1 < Structures.size(); ++i) covered += Structures[i].Size.x * Structures[i].Size.y;
+    const Play::Point2D floor = Structures.back().Size;
+    return covered / (floor.x * floor.y);
+}
+
+std::string ArenaName(const ArenaSpec& spec)
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "%.0fx%.0f@%.2f", spec.width, spec.height, spec.density);
+    return name;
+}
+
+} // namespace Bench
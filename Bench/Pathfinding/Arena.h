@@ -0,0 +1,32 @@
+#pragma once
+
+/// @brief Generated arenas for the pathfinding benchmarks: a walled rectangle scattered with boxes.
+
+#include "Pathfinding/Types.h"
+#include <cstdint>
+#include <string>
+
+namespace Bench {
+
+struct ArenaSpec {
+  float width{1280.0f};
+  float height{720.0f};
+  float density{0.15f};   // fraction of the floor covered by boxes (before inflation)
+  float minBox{40.0f};    // box side range (px)
+  float maxBox{140.0f};
+  std::uint32_t seed{1};
+};
+
+// Replaces the global Structures with the arena's boxes followed by its outer wall (last, like the
+// game lays them out) and returns the game's pathfinding config for it. Boxes do not overlap but may
+// sit closer than a tank, so dense arenas have dead ends and unreachable pockets like real maps.
+// Placement stops once 'density' is reached or boxes stop fitting.
+Pathfinding::PathfindingConfig GenerateArena(const ArenaSpec& spec);
+
+// Fraction of the floor the current Structures cover (what GenerateArena actually reached)
+float ArenaCoverage();
+
+// Label used in reports, e.g. "1280x720@0.15"
+std::string ArenaName(const ArenaSpec& spec);
+
+} // namespace Bench
@@ -0,0 +1,392 @@
+// Pathfinding micro-benchmarks on generated arenas.
+//
+//   tankai_bench_pathfinding [--sizes 1280x720,2560x1440] [--densities 0.10,0.25] [--samples 2000]
+//                            [--seed 1] [--all-pairs] [--cluster PX] [--path-cache] [--label TEXT]
+//                            [--json FILE]
+//
+// Every arena is timed for graph construction (BuildCenterlineGraph, and the brute-force reference
+// it is checked against), Rebuild, PlanPath, FindPath vs FindPathBidirectional on the same attachments,
+// ProjectToWalkable, IsReachable, raw-structure LOS, obstacle segment tests (linear and through the
+// ObstacleSet grid) and BuildMotionPrimitives (also with arc clearance against the static obstacles,
+// "+clr"). Query inputs are drawn up front from the seed, so runs with the same arguments time the
+// same work. The JSON report is meant to be kept per commit and compared. Consistency checks
+// (reference graph, grid segment tests, bidirectional costs, repaired paths, and the BoxTable kernel
+// against the scalar segment test) make the exit code 1.
+
+#include "Arena.h"
+#include "Harness.h"
+#include "Pathfinding/Pathfinding.h"
+#include "Pathfinding/AStar/AStar.h"
+#include "Pathfinding/AStar/SearchContext.h"
+#include "Pathfinding/Graph/GraphOverlay.h"
+#include "Pathfinding/Graph/GraphBuilder.h"
+#include "Obstacles/Structures.h"
+#include "Helper/LineOfSight.h"
+#include "Helper/BoxTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::pair<float, float>> sizes{ { 1280.0f, 720.0f }, { 2560.0f, 1440.0f } };
+    std::vector<float> densities{ 0.10f, 0.25f };
+    int samples{ 2000 };
+    std::uint32_t seed{ 1 };
+    bool allPairs{ false };
+    float clusterSize{ 0.0f };
+    bool pathCache{ false };
+    std::string label{};
+    std::string jsonPath{};
+};
+
+// Rebuilds are orders of magnitude slower than queries; time fewer of them
+constexpr int kRebuildDivisor = 100;
+constexpr int kMinRebuildSamples = 5;
+
+// Half extent of the boxes dropped on paths by the dynamic-obstacle run
+constexpr float kDynamicHalfSize = 12.0f;
+
+std::vector<std::string> SplitList(const char* text)
+{
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    for (std::string part; std::getline(stream, part, ',');) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+// Node positions and (from, to, cost) edges in a canonical order, so graphs built with different node
+// numbering compare equal
+struct GraphKey {
+    std::vector<std::pair<float, float>> nodes;
+    std::vector<std::tuple<float, float, float, float, float>> edges;
+    bool operator==(const GraphKey&) const = default;
+};
+
+GraphKey KeyOf(const Pathfinding::Graph& g)
+{
+    GraphKey key;
+    for (int u = 0; u < g.size(); ++u) {
+        key.nodes.emplace_back(g.x(u), g.y(u));
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const int v = g.edgeTarget(e);
+            key.edges.emplace_back(g.x(u), g.y(u), g.x(v), g.y(v), g.edgeCost(e));
+        }
+    }
+    std::sort(key.nodes.begin(), key.nodes.end());
+    std::sort(key.edges.begin(), key.edges.end());
+    return key;
+}
+
+bool ParseOptions(const int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--sizes") && hasValue) {
+            opt.sizes.clear();
+            for (const std::string& s : SplitList(argv[++i])) {
+                float w = 0.0f, h = 0.0f;
+                if (std::sscanf(s.c_str(), "%fx%f", &w, &h) != 2 || w <= 0.0f || h <= 0.0f) return false;
+                opt.sizes.emplace_back(w, h);
+            }
+        } else if (!std::strcmp(arg, "--densities") && hasValue) {
+            opt.densities.clear();
+            for (const std::string& s : SplitList(argv[++i])) opt.densities.push_back(std::strtof(s.c_str(), nullptr));
+        } else if (!std::strcmp(arg, "--samples") && hasValue) {
+            opt.samples = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(arg, "--seed") && hasValue) {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!std::strcmp(arg, "--cluster") && hasValue) {
+            opt.clusterSize = std::strtof(argv[++i], nullptr);
+        } else if (!std::strcmp(arg, "--label") && hasValue) {
+            opt.label = argv[++i];
+        } else if (!std::strcmp(arg, "--json") && hasValue) {
+            opt.jsonPath = argv[++i];
+        } else if (!std::strcmp(arg, "--all-pairs")) {
+            opt.allPairs = true;
+        } else if (!std::strcmp(arg, "--path-cache")) {
+            opt.pathCache = true;
+        } else {
+            return false;
+        }
+    }
+    return !opt.sizes.empty() && !opt.densities.empty();
+}
+
+// Returns the number of failed consistency checks
+int BenchArena(Bench::Harness& harness, const Options& opt, const Bench::ArenaSpec& spec)
+{
+    using namespace Pathfinding;
+
+    PathfindingConfig params = Bench::GenerateArena(spec);
+    params.precomputeAllPairs = opt.allPairs;
+    params.hierarchyClusterSize = opt.clusterSize;
+    if (!opt.pathCache) params.pathCacheCapacity = 0; // time the planner, not cache hits
+    const std::string arena = Bench::ArenaName(spec);
+    const int rebuilds = std::max(kMinRebuildSamples, opt.samples / kRebuildDivisor);
+
+    // Graph construction alone, then everything Rebuild derives from it
+    const Rect playArea = GetOuterPlayableRect(params);
+    const std::vector<Rect> obstacles = BuildInflatedObstacles(params);
+    Graph graph;
+    harness.Run("BuildCenterlineGraph", arena, rebuilds, 1, [&](int) {
+        BuildCenterlineGraph(playArea, obstacles, graph);
+        return graph.size();
+    });
+
+    // The grid builder must reproduce the brute-force reference exactly
+    int failures = 0;
+    Graph reference;
+    harness.Run("BuildCenterlineGraphReference", arena, kMinRebuildSamples, 0, [&](int) {
+        BuildCenterlineGraphReference(playArea, obstacles, reference);
+        return reference.size();
+    });
+    if (!(KeyOf(graph) == KeyOf(reference))) {
+        std::fprintf(stderr, "%s: built graph (%d nodes, %d edges) differs from the reference (%d nodes, %d edges)\n",
+                     arena.c_str(), graph.size(), graph.edgeCount(), reference.size(), reference.edgeCount());
+        ++failures;
+    }
+
+    PathfinderService pf;
+    pf.SetConfig(params);
+    harness.Run("Rebuild", arena, rebuilds, 1, [&](int) {
+        pf.Rebuild();
+        return pf.GetGraph().size();
+    });
+    harness.AddMetadata(arena + ".structures", std::to_string(Structures.size() - 1));
+    harness.AddMetadata(arena + ".coverage", std::to_string(Bench::ArenaCoverage()));
+    harness.AddMetadata(arena + ".nodes", std::to_string(pf.GetGraph().size()));
+    harness.AddMetadata(arena + ".edges", std::to_string(pf.GetGraph().edgeCount() / 2));
+
+    // Query inputs: points anywhere in the arena (inside boxes too, like stale or projected targets)
+    std::mt19937 rng(spec.seed ^ 0x9e3779b9u);
+    std::uniform_real_distribution<float> x(0.0f, spec.width), y(0.0f, spec.height);
+    std::vector<Play::Vector2D> points(2 * static_cast<size_t>(opt.samples));
+    for (auto& p : points) p = { x(rng), y(rng) };
+    auto from = [&](const int i) { return points[2 * i]; };
+    auto to = [&](const int i) { return points[2 * i + 1]; };
+    const int warmup = std::min(opt.samples, 64);
+
+    SearchContext ctx;
+    std::vector<std::vector<Play::Vector2D>> polylines;
+    polylines.reserve(opt.samples);
+    harness.Run("PlanPath", arena, opt.samples, warmup, [&](const int i) {
+        auto result = pf.PlanPath(from(i), to(i), ctx);
+        if (result && result->polyline.size() >= 3) polylines.push_back(std::move(result->polyline));
+        return result.has_value();
+    });
+
+    // Plain and bidirectional A* between the same attachment points must agree on the cost
+    std::vector<std::pair<GraphAnchor, GraphAnchor>> anchors(opt.samples);
+    for (int i = 0; i < opt.samples; ++i) anchors[i] = { pf.FindAttachment(from(i)), pf.FindAttachment(to(i)) };
+    std::vector<float> costs(opt.samples), bidiCosts(opt.samples);
+    std::vector<int> nodePath;
+    SearchContext bwd;
+    harness.Run("FindPath", arena, opt.samples, warmup, [&](const int i) {
+        GraphOverlay overlay(pf.GetGraph());
+        const int s = overlay.attach(anchors[i].first), g = overlay.attach(anchors[i].second);
+        const bool found = s >= 0 && g >= 0 && FindPath(overlay, s, g, ctx, nodePath, &costs[i]);
+        if (!found) costs[i] = -1.0f;
+        return found;
+    });
+    harness.Run("FindPathBidirectional", arena, opt.samples, warmup, [&](const int i) {
+        GraphOverlay overlay(pf.GetGraph());
+        const int s = overlay.attach(anchors[i].first), g = overlay.attach(anchors[i].second);
+        const bool found = s >= 0 && g >= 0 && FindPathBidirectional(overlay, s, g, ctx, bwd, nodePath, &bidiCosts[i]);
+        if (!found) bidiCosts[i] = -1.0f;
+        return found;
+    });
+    int costMismatches = 0;
+    for (int i = 0; i < opt.samples; ++i) {
+        if (std::abs(bidiCosts[i] - costs[i]) > 1e-3f * std::max(1.0f, costs[i])) ++costMismatches;
+    }
+    if (costMismatches > 0) {
+        std::fprintf(stderr, "%s: %d bidirectional searches disagree with FindPath on the cost\n", arena.c_str(), costMismatches);
+        failures += costMismatches;
+    }
+
+    harness.Run("ProjectToWalkable", arena, opt.samples, warmup, [&](const int i) {
+        const Play::Vector2D p = pf.ProjectToWalkable(from(i));
+        return p.x != 0.0f || p.y != 0.0f;
+    });
+
+    harness.Run("IsReachable", arena, opt.samples, warmup, [&](const int i) { return pf.IsReachable(from(i), to(i)); });
+
+    // Raw-structure LOS through the SIMD table GenerateArena set up
+    harness.Run("HasLOS_RawStructures", arena, opt.samples, warmup, [&](const int i) {
+        return LOSHelper::HasLOS_RawStructures(from(i), to(i));
+    });
+
+    // Segment tests against the inflated obstacles: linear scan vs the ObstacleSet grid, same answers
+    const ObstacleSet& staticObstacles = pf.GetStaticObstacles();
+    std::vector<std::uint8_t> linearHits(opt.samples), gridHits(opt.samples);
+    harness.Run("SegmentHitsAnyRect", arena, opt.samples, warmup, [&](const int i) {
+        return linearHits[i] = SegmentHitsAnyRect(from(i), to(i), staticObstacles.Rects());
+    });
+    harness.Run("ObstacleSet::SegmentHitsAny", arena, opt.samples, warmup, [&](const int i) {
+        return gridHits[i] = staticObstacles.SegmentHitsAny(from(i), to(i));
+    });
+    if (linearHits != gridHits) {
+        std::fprintf(stderr, "%s: ObstacleSet segment tests disagree with the linear scan\n", arena.c_str());
+        ++failures;
+    }
+
+    // Dynamic obstacles: drop a box on the middle of a planned path, repair the path with D* Lite
+    // and lift the box again. A repaired path must not cross the (inflated) box.
+    if (!polylines.empty()) {
+        int unrepaired = 0, crossings = 0;
+        PathRepairState repair;
+        PathResult repaired;
+        harness.Run("Add+RepairPath+Remove", arena, opt.samples, warmup, [&](const int i) {
+            const std::vector<Play::Vector2D>& path = polylines[i % polylines.size()];
+            const size_t mid = path.size() / 2;
+            const Play::Vector2D at{ (path[mid - 1].x + path[mid].x) * 0.5f, (path[mid - 1].y + path[mid].y) * 0.5f };
+
+            repair.Reset(path.back(), pf.GetNavVersion());
+            const auto id = pf.AddDynamicObstacle({ at.x - kDynamicHalfSize, at.y - kDynamicHalfSize, at.x + kDynamicHalfSize, at.y + kDynamicHalfSize });
+            const Rect box = pf.GetDynamicObstacles().back();
+            const auto outcome = pf.RepairPath(repair, path.front(), path, repaired);
+            pf.RemoveDynamicObstacle(id);
+
+            // Endpoints under the box have no clear way out; nothing to check there
+            if (PointInRect(path.front(), box) || PointInRect(path.back(), box)) return 0;
+            if (outcome == PathfinderService::RepairOutcome::Unchanged) ++unrepaired;
+            if (outcome == PathfinderService::RepairOutcome::Repaired) {
+                for (size_t k = 1; k < repaired.polyline.size(); ++k) {
+                    if (SegmentIntersectsRect(repaired.polyline[k - 1], repaired.polyline[k], box)) { ++crossings; break; }
+                }
+            }
+            return static_cast<int>(outcome);
+        });
+        if (unrepaired + crossings > 0) {
+            std::fprintf(stderr, "%s: %d paths left unrepaired, %d repaired paths cross the obstacle\n", arena.c_str(), unrepaired, crossings);
+            failures += unrepaired + crossings;
+        }
+    }
+
+    // Corner smoothing of the planned paths (only those with at least one corner)
+    if (!polylines.empty()) {
+        MotionPrimitives prims;
+        harness.Run("BuildMotionPrimitives", arena, opt.samples, warmup, [&](const int i) {
+            return BuildMotionPrimitives(polylines[i % polylines.size()], params.turnRadius, params, prims);
+        });
+        harness.Run("BuildMotionPrimitives+clr", arena, opt.samples, warmup, [&](const int i) {
+            return BuildMotionPrimitives(polylines[i % polylines.size()], params.turnRadius, params, prims, nullptr, &pf.GetStaticObstacles());
+        });
+    }
+    return failures;
+}
+
+// The compiled Geom::BoxTable kernel against the scalar SegmentIntersectsRect, one box at a time and
+// over whole tables whose sizes leave padding lanes for every kernel width. Segments are random plus,
+// per box, every pair of points on a lattice through its bounds (zero-length, axis-parallel, touching
+// an edge or a corner, just outside). Returns the number of disagreeing answers.
+int CheckBoxTable(const std::uint32_t seed)
+{
+    using namespace Pathfinding;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, 256.0f), side(1.0f, 64.0f);
+    int mismatches = 0;
+
+    auto check = [&](const std::vector<Rect>& rects, const std::vector<Geom::Segment>& segments) {
+        std::vector<Geom::Box> boxes;
+        for (const auto& [minx, miny, maxx, maxy] : rects) boxes.push_back({ minx, miny, maxx, maxy });
+        Geom::BoxTable table;
+        table.Assign(boxes);
+
+        std::vector<std::uint8_t> batch(segments.size());
+        table.SegmentsHitAny(segments, batch);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const auto& [a, b] = segments[i];
+            const bool expected = std::ranges::any_of(rects, [&](const Rect& r) { return SegmentIntersectsRect(a, b, r); });
+            if (table.SegmentHitsAny(a, b) != expected) ++mismatches;
+            if ((batch[i] != 0) != expected) ++mismatches;
+        }
+    };
+
+    for (int count = 1; count <= 2 * static_cast<int>(Geom::BoxTable::kLanes) + 1; ++count) {
+        std::vector<Rect> rects;
+        for (int i = 0; i < count; ++i) {
+            const float x = coord(rng), y = coord(rng);
+            rects.push_back({ x, y, x + side(rng), y + side(rng) });
+        }
+
+        std::vector<Geom::Segment> segments;
+        for (int i = 0; i < 256; ++i) segments.push_back({ { coord(rng), coord(rng) }, { coord(rng), coord(rng) } });
+        for (const Rect& r : rects) {
+            const float xs[] = { r.minx - 8.0f, r.minx, std::nextafter(r.minx, -1.0f), (r.minx + r.maxx) * 0.5f, r.maxx, r.maxx + 8.0f };
+            const float ys[] = { r.miny - 8.0f, r.miny, std::nextafter(r.miny, -1.0f), (r.miny + r.maxy) * 0.5f, r.maxy, r.maxy + 8.0f };
+            std::vector<Play::Vector2D> lattice;
+            for (const float x : xs) {
+                for (const float y : ys) lattice.push_back({ x, y });
+            }
+            std::vector<Geom::Segment> local;
+            for (const auto& a : lattice) {
+                for (const auto& b : lattice) local.push_back({ a, b });
+            }
+            check({ r }, local);
+            segments.insert(segments.end(), local.begin(), local.end());
+        }
+        check(rects, segments);
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "usage: %s [--sizes WxH,...] [--densities d,...] [--samples N] [--seed S] [--all-pairs] "
+                     "[--cluster PX] [--path-cache] [--label TEXT] [--json FILE]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    Bench::Harness harness;
+    harness.AddMetadata("label", opt.label);
+    harness.AddMetadata("samples", std::to_string(opt.samples));
+    harness.AddMetadata("seed", std::to_string(opt.seed));
+    harness.AddMetadata("planner", opt.allPairs ? "all-pairs" : opt.clusterSize > 0.0f ? "hierarchical" : "a*");
+    harness.AddMetadata("path_cache", opt.pathCache ? "on" : "off");
+    harness.AddMetadata("simd", Geom::BoxTable::KernelName());
+
+    int failures = 0;
+    if (const int mismatches = CheckBoxTable(opt.seed); mismatches > 0) {
+        std::fprintf(stderr, "BoxTable (%s): %d answers differ from SegmentIntersectsRect\n", Geom::BoxTable::KernelName(), mismatches);
+        failures += mismatches;
+    }
+
+    for (const auto& [w, h] : opt.sizes) {
+        for (const float density : opt.densities) {
+            Bench::ArenaSpec spec;
+            spec.width = w;
+            spec.height = h;
+            spec.density = density;
+            spec.seed = opt.seed;
+            failures += BenchArena(harness, opt, spec);
+        }
+    }
+
+    harness.PrintTable(stdout);
+    if (!opt.jsonPath.empty() && !harness.WriteJson(opt.jsonPath)) {
+        std::fprintf(stderr, "could not write %s\n", opt.jsonPath.c_str());
+        return 1;
+    }
+    return failures > 0 ? 1 : 0;
+}
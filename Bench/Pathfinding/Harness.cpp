@@ -0,0 +1,76 @@
+#include "Harness.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Bench {
+
+// Nearest-rank percentile of sorted samples
+static double Percentile(const std::vector<double>& sorted, const double p)
+{
+    if (sorted.empty()) return 0.0;
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static std::string Escape(const std::string& s)
+{
+    std::string out;
+    for (const char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+Result Harness::Summarise(const std::string& name, const std::string& arena)
+{
+    Result r{ name, arena, static_cast<int>(m_samples.size()) };
+    if (m_samples.empty()) return r;
+
+    std::ranges::sort(m_samples);
+    const double total = std::accumulate(m_samples.begin(), m_samples.end(), 0.0);
+    r.minUs = m_samples.front();
+    r.maxUs = m_samples.back();
+    r.meanUs = total / static_cast<double>(m_samples.size());
+    r.p50Us = Percentile(m_samples, 0.50);
+    r.p90Us = Percentile(m_samples, 0.90);
+    r.p99Us = Percentile(m_samples, 0.99);
+    r.opsPerSec = total > 0.0 ? 1e6 * static_cast<double>(m_samples.size()) / total : 0.0;
+    return r;
+}
+
+void Harness::PrintTable(std::FILE* out) const
+{
+    std::fprintf(out, "%-28s %-16s %8s %10s %10s %10s %10s %12s\n", "benchmark", "arena", "samples", "p50 us", "p90 us",
+                 "p99 us", "max us", "ops/s");
+    for (const Result& r : m_results) {
+        std::fprintf(out, "%-28s %-16s %8d %10.2f %10.2f %10.2f %10.2f %12.0f\n", r.name.c_str(), r.arena.c_str(), r.samples,
+                     r.p50Us, r.p90Us, r.p99Us, r.maxUs, r.opsPerSec);
+    }
+}
+
+bool Harness::WriteJson(const std::string& path) const
+{
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) return false;
+
+    std::fprintf(out, "{\n  \"metadata\": {");
+    for (size_t i = 0; i < m_metadata.size(); ++i) {
+        std::fprintf(out, "%s\n    \"%s\": \"%s\"", i ? "," : "", Escape(m_metadata[i].first).c_str(),
+                     Escape(m_metadata[i].second).c_str());
+    }
+    std::fprintf(out, "\n  },\n  \"results\": [");
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result& r = m_results[i];
+        std::fprintf(out,
+                     "%s\n    {\"name\": \"%s\", \"arena\": \"%s\", \"samples\": %d, \"min_us\": %.3f, \"mean_us\": %.3f, "
+                     "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, \"ops_per_sec\": %.1f}",
+                     i ? "," : "", Escape(r.name).c_str(), Escape(r.arena).c_str(), r.samples, r.minUs, r.meanUs, r.p50Us,
+                     r.p90Us, r.p99Us, r.maxUs, r.opsPerSec);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    return std::fclose(out) == 0;
+}
+
+} // namespace Bench
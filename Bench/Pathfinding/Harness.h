@@ -0,0 +1,66 @@
+#pragma once
+
+/// @brief Minimal benchmark harness: per-call latency samples, percentiles and a JSON report.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Bench {
+
+// Latency summary of one benchmark on one arena (microseconds per call)
+struct Result {
+  std::string name;
+  std::string arena;
+  int samples{ 0 };
+  double minUs{ 0.0 }, meanUs{ 0.0 }, p50Us{ 0.0 }, p90Us{ 0.0 }, p99Us{ 0.0 }, maxUs{ 0.0 };
+  double opsPerSec{ 0.0 };
+};
+
+// Free-form key/value pairs written into the report header (arena graph sizes, planner options...)
+using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+class Harness {
+public:
+  // Times fn(i) once for every i in [0, samples), after 'warmup' untimed calls with i = 0..warmup-1.
+  // fn returns something cheap derived from its work (a size, a bool) so it cannot be optimised away.
+  template <typename Fn>
+  const Result& Run(const std::string& name, const std::string& arena, const int samples, const int warmup, Fn&& fn)
+  {
+    for (int i = 0; i < warmup; ++i) Consume(fn(i));
+
+    m_samples.resize(samples);
+    for (int i = 0; i < samples; ++i) {
+      const auto t0 = std::chrono::steady_clock::now();
+      Consume(fn(i));
+      m_samples[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    }
+    m_results.push_back(Summarise(name, arena));
+    return m_results.back();
+  }
+
+  void AddMetadata(std::string key, std::string value) { m_metadata.emplace_back(std::move(key), std::move(value)); }
+
+  [[nodiscard]] const std::vector<Result>& Results() const { return m_results; }
+
+  // Human-readable table, one line per result
+  void PrintTable(std::FILE* out) const;
+
+  // {"metadata": {...}, "results": [{name, arena, samples, min_us, mean_us, p50_us, p90_us, p99_us, max_us, ops_per_sec}, ...]}
+  bool WriteJson(const std::string& path) const;
+
+private:
+  template <typename T>
+  void Consume(const T& value) { m_sink = m_sink + static_cast<unsigned>(static_cast<bool>(value)); }
+
+  [[nodiscard]] Result Summarise(const std::string& name, const std::string& arena);
+
+  std::vector<double> m_samples{};
+  std::vector<Result> m_results{};
+  Metadata m_metadata{};
+  volatile unsigned m_sink{ 0 };
+};
+
+} // namespace Bench
@@ -5,9 +5,10 @@
 #include "Obstacles/Structures.h"
 
 std::vector<Bullet*> Bullet::BulletList;
+std::uint32_t Bullet::NextSerial = 0;
 
 Bullet::Bullet(const Play::Vector2D& StartPos, const Play::Vector2D& Velocity, const float MaxDistance, const int OwnerId)
-    : Pos(StartPos), Velocity(Velocity), MaxDistance(MaxDistance), OwnerId(OwnerId)
+    : Pos(StartPos), Velocity(Velocity), MaxDistance(MaxDistance), OwnerId(OwnerId), Serial(NextSerial++)
 {
     std::string spriteName = "Bullet" + std::to_string(OwnerId + 1);
     SpriteId = Play::Graphics::GetSpriteId(spriteName.c_str());
@@ -4,6 +4,7 @@
 
 #include "Play.h"
 #include <vector>
+#include <cstdint>
 
 class Tank;
 
@@ -15,8 +16,12 @@ public:
 	bool IsAlive() const;
 
 	Play::Vector2D GetPosition() const { return Pos; }
+	Play::Vector2D GetVelocity() const { return Velocity; }
+	float GetRemainingDistance() const { return MaxDistance - DistanceTraveled; }
 	float GetRadius() const { return Radius; }
 	int GetOwnerId() const { return OwnerId; }
+	// Unique per bullet for the whole game (addresses are reused by later bullets)
+	std::uint32_t GetSerial() const { return Serial; }
 
 	static void CreateBullet(const Play::Vector2D& StartPos, const Play::Vector2D& Velocity, const float MaxDistance, const int OwnerId);
 	static std::vector<Bullet*>& GetAllBullets() { return BulletList; }
@@ -31,6 +36,7 @@ private:
 	float Radius = 4.0f;
 	int OwnerId;
     int SpriteId;
+	std::uint32_t Serial;
 
     bool bHasLeftOuterWall = false;
 
@@ -39,6 +45,7 @@ private:
 
 	// Static vector of all Bullets
 	static std::vector<Bullet*> BulletList;
+	static std::uint32_t NextSerial;
 };
 
 #endif
@@ -0,0 +1,192 @@
+#include "Helper/BoxTable.h"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+// Kernel selection: TANKAI_SIMD_SCALAR forces the portable loop; otherwise the widest of AVX2 / SSE2
+// the compiler targets (x86-64 always has SSE2)
+#if !defined(TANKAI_SIMD_SCALAR) && defined(__AVX2__)
+#define BOXTABLE_AVX2 1
+#include <immintrin.h>
+#elif !defined(TANKAI_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BOXTABLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Geom {
+
+namespace {
+
+// Per-segment part of the Liang-Barsky test. An axis is either parallel (only the inside test applies)
+// or has its entering and leaving sides fixed by the sign of its delta, the same for every box. The
+// t values below are computed with exactly the scalar test's operands, so results match bit for bit.
+struct Slab {
+    float ax, ay;
+    float dx, dy;
+    bool parX, parY;
+
+    Slab(const Play::Vector2D& a, const Play::Vector2D& b)
+        : ax(a.x), ay(a.y), dx(b.x - a.x), dy(b.y - a.y),
+          parX(std::abs(b.x - a.x) < 1e-6f), parY(std::abs(b.y - a.y) < 1e-6f) {}
+};
+
+#if defined(BOXTABLE_AVX2)
+
+bool HitsAnyKernel(const Slab& s, const float* minx, const float* miny, const float* maxx, const float* maxy, const size_t padded)
+{
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+    const __m256 ax = _mm256_set1_ps(s.ax), ay = _mm256_set1_ps(s.ay);
+    const __m256 ndx = _mm256_set1_ps(-s.dx), pdx = _mm256_set1_ps(s.dx);
+    const __m256 ndy = _mm256_set1_ps(-s.dy), pdy = _mm256_set1_ps(s.dy);
+    for (size_t i = 0; i < padded; i += 8) {
+        __m256 u1 = zero, u2 = one;
+        __m256 ok = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        const __m256 qx0 = _mm256_sub_ps(ax, _mm256_loadu_ps(minx + i)), qx1 = _mm256_sub_ps(_mm256_loadu_ps(maxx + i), ax);
+        if (s.parX) {
+            ok = _mm256_and_ps(_mm256_cmp_ps(qx0, zero, _CMP_GE_OQ), _mm256_cmp_ps(qx1, zero, _CMP_GE_OQ));
+        } else {
+            const __m256 t0 = _mm256_div_ps(qx0, ndx), t1 = _mm256_div_ps(qx1, pdx);
+            u1 = _mm256_max_ps(u1, s.dx > 0.0f ? t0 : t1);
+            u2 = _mm256_min_ps(u2, s.dx > 0.0f ? t1 : t0);
+        }
+        const __m256 qy0 = _mm256_sub_ps(ay, _mm256_loadu_ps(miny + i)), qy1 = _mm256_sub_ps(_mm256_loadu_ps(maxy + i), ay);
+        if (s.parY) {
+            ok = _mm256_and_ps(ok, _mm256_and_ps(_mm256_cmp_ps(qy0, zero, _CMP_GE_OQ), _mm256_cmp_ps(qy1, zero, _CMP_GE_OQ)));
+        } else {
+            const __m256 t0 = _mm256_div_ps(qy0, ndy), t1 = _mm256_div_ps(qy1, pdy);
+            u1 = _mm256_max_ps(u1, s.dy > 0.0f ? t0 : t1);
+            u2 = _mm256_min_ps(u2, s.dy > 0.0f ? t1 : t0);
+        }
+        if (_mm256_movemask_ps(_mm256_and_ps(ok, _mm256_cmp_ps(u1, u2, _CMP_LE_OQ)))) return true;
+    }
+    return false;
+}
+
+#elif defined(BOXTABLE_SSE2)
+
+bool HitsAnyKernel(const Slab& s, const float* minx, const float* miny, const float* maxx, const float* maxy, const size_t padded)
+{
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    const __m128 ax = _mm_set1_ps(s.ax), ay = _mm_set1_ps(s.ay);
+    const __m128 ndx = _mm_set1_ps(-s.dx), pdx = _mm_set1_ps(s.dx);
+    const __m128 ndy = _mm_set1_ps(-s.dy), pdy = _mm_set1_ps(s.dy);
+    for (size_t i = 0; i < padded; i += 4) {
+        __m128 u1 = zero, u2 = one;
+        __m128 ok = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        const __m128 qx0 = _mm_sub_ps(ax, _mm_loadu_ps(minx + i)), qx1 = _mm_sub_ps(_mm_loadu_ps(maxx + i), ax);
+        if (s.parX) {
+            ok = _mm_and_ps(_mm_cmpge_ps(qx0, zero), _mm_cmpge_ps(qx1, zero));
+        } else {
+            const __m128 t0 = _mm_div_ps(qx0, ndx), t1 = _mm_div_ps(qx1, pdx);
+            u1 = _mm_max_ps(u1, s.dx > 0.0f ? t0 : t1);
+            u2 = _mm_min_ps(u2, s.dx > 0.0f ? t1 : t0);
+        }
+        const __m128 qy0 = _mm_sub_ps(ay, _mm_loadu_ps(miny + i)), qy1 = _mm_sub_ps(_mm_loadu_ps(maxy + i), ay);
+        if (s.parY) {
+            ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(qy0, zero), _mm_cmpge_ps(qy1, zero)));
+        } else {
+            const __m128 t0 = _mm_div_ps(qy0, ndy), t1 = _mm_div_ps(qy1, pdy);
+            u1 = _mm_max_ps(u1, s.dy > 0.0f ? t0 : t1);
+            u2 = _mm_min_ps(u2, s.dy > 0.0f ? t1 : t0);
+        }
+        if (_mm_movemask_ps(_mm_and_ps(ok, _mm_cmple_ps(u1, u2)))) return true;
+    }
+    return false;
+}
+
+#else
+
+bool HitsBoxScalar(const Slab& s, const float minx, const float miny, const float maxx, const float maxy)
+{
+    float u1 = 0.0f, u2 = 1.0f;
+    const float qx0 = s.ax - minx, qx1 = maxx - s.ax;
+    if (s.parX) {
+        if (qx0 < 0.0f || qx1 < 0.0f) return false;
+    } else {
+        const float t0 = qx0 / -s.dx, t1 = qx1 / s.dx;
+        u1 = std::max(u1, s.dx > 0.0f ? t0 : t1);
+        u2 = std::min(u2, s.dx > 0.0f ? t1 : t0);
+    }
+    const float qy0 = s.ay - miny, qy1 = maxy - s.ay;
+    if (s.parY) {
+        if (qy0 < 0.0f || qy1 < 0.0f) return false;
+    } else {
+        const float t0 = qy0 / -s.dy, t1 = qy1 / s.dy;
+        u1 = std::max(u1, s.dy > 0.0f ? t0 : t1);
+        u2 = std::min(u2, s.dy > 0.0f ? t1 : t0);
+    }
+    return u1 <= u2;
+}
+
+bool HitsAnyKernel(const Slab& s, const float* minx, const float* miny, const float* maxx, const float* maxy, const size_t padded)
+{
+    for (size_t i = 0; i < padded; ++i) {
+        if (HitsBoxScalar(s, minx[i], miny[i], maxx[i], maxy[i])) return true;
+    }
+    return false;
+}
+
+#endif
+
+} // namespace
+
+void BoxTable::Assign(const std::span<const Box> boxes)
+{
+    m_count = boxes.size();
+    const size_t padded = (m_count + kLanes - 1) / kLanes * kLanes;
+
+    // Padding boxes are inverted (min > max), which every kernel rejects
+    constexpr float hi = std::numeric_limits<float>::max(), lo = std::numeric_limits<float>::lowest();
+    m_minx.assign(padded, hi);
+    m_miny.assign(padded, hi);
+    m_maxx.assign(padded, lo);
+    m_maxy.assign(padded, lo);
+    for (size_t i = 0; i < m_count; ++i) {
+        m_minx[i] = boxes[i].minx;
+        m_miny[i] = boxes[i].miny;
+        m_maxx[i] = boxes[i].maxx;
+        m_maxy[i] = boxes[i].maxy;
+    }
+}
+
+void BoxTable::clear()
+{
+    m_count = 0;
+    m_minx.clear();
+    m_miny.clear();
+    m_maxx.clear();
+    m_maxy.clear();
+}
+
+bool BoxTable::SegmentHitsAny(const Play::Vector2D& a, const Play::Vector2D& b) const
+{
+    if (m_count == 0) return false;
+    return HitsAnyKernel(Slab(a, b), m_minx.data(), m_miny.data(), m_maxx.data(), m_maxy.data(), m_minx.size());
+}
+
+void BoxTable::SegmentsHitAny(const std::span<const Segment> segments, const std::span<std::uint8_t> outHit) const
+{
+    const size_t n = std::min(segments.size(), outHit.size());
+    if (m_count == 0) {
+        std::fill_n(outHit.begin(), n, std::uint8_t{ 0 });
+        return;
+    }
+    const float *minx = m_minx.data(), *miny = m_miny.data(), *maxx = m_maxx.data(), *maxy = m_maxy.data();
+    const size_t padded = m_minx.size();
+    for (size_t i = 0; i < n; ++i) {
+        outHit[i] = HitsAnyKernel(Slab(segments[i].a, segments[i].b), minx, miny, maxx, maxy, padded) ? 1 : 0;
+    }
+}
+
+const char* BoxTable::KernelName()
+{
+#if defined(BOXTABLE_AVX2)
+    return "avx2";
+#elif defined(BOXTABLE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace Geom
@@ -0,0 +1,45 @@
+#pragma once
+
+/// @brief Axis-aligned boxes in structure-of-arrays form with SIMD segment-vs-box slab tests.
+
+#include "Helper/RectGrid.h" // Geom::Box
+#include <Play.h>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace Geom {
+
+struct Segment {
+  Play::Vector2D a{};
+  Play::Vector2D b{};
+};
+
+// minx/miny/maxx/maxy arrays padded to a whole number of SIMD lanes with boxes no segment can hit.
+// The kernel tests one segment against 8 (AVX2), 4 (SSE2) or 1 (scalar) boxes per step; which one is
+// chosen at build time (TANKAI_SIMD in CMake, scalar on non-x86). Results are exactly those of the
+// Liang-Barsky test in LOSHelper / Pathfinding::SegmentIntersectsRect (touching counts as a hit).
+class BoxTable {
+public:
+  static constexpr size_t kLanes = 8; // padding granularity (widest kernel)
+
+  void Assign(std::span<const Box> boxes);
+  void clear();
+  [[nodiscard]] size_t size() const { return m_count; }
+  [[nodiscard]] bool empty() const { return m_count == 0; }
+
+  // True if the segment touches or crosses any box
+  [[nodiscard]] bool SegmentHitsAny(const Play::Vector2D& a, const Play::Vector2D& b) const;
+
+  // outHit[i] = SegmentHitsAny(segments[i]) (outHit must be at least as long as segments)
+  void SegmentsHitAny(std::span<const Segment> segments, std::span<std::uint8_t> outHit) const;
+
+  // Kernel compiled in: "avx2", "sse2" or "scalar"
+  [[nodiscard]] static const char* KernelName();
+
+private:
+  std::vector<float> m_minx{}, m_miny{}, m_maxx{}, m_maxy{};
+  size_t m_count{ 0 };
+};
+
+} // namespace Geom
@@ -47,6 +47,24 @@ inline float dist(const Play::Vector2D& a, const Play::Vector2D& b) {
   return std::sqrt(dist2(a, b));
 }
 
+// Project point p onto segment a-b.
+// Returns the projected point and writes the clamped parameter t in [0,1] into outT.
+inline Play::Vector2D projectOnSegment(const Play::Vector2D& p, const Play::Vector2D& a, const Play::Vector2D& b, float& outT) {
+  const float dirX = b.x - a.x;
+  const float dirY = b.y - a.y;
+  const float len2 = dirX*dirX + dirY*dirY;
+
+  // Degenerate segment: return endpoint a
+  if (len2 <= 1e-6f) {
+    outT = 0.0f;
+    return a;
+  }
+
+  const float t = clampf((dirX*(p.x - a.x) + dirY*(p.y - a.y)) / len2, 0.0f, 1.0f);
+  outT = t;
+  return Play::Vector2D{ a.x + t*dirX, a.y + t*dirY };
+}
+
 // Wrap angle to [-pi, pi]
 inline float wrapAngle(float a) {
   while (a > Play::PLAY_PI)  a -= 2.0f * Play::PLAY_PI;
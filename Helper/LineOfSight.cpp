@@ -1,5 +1,6 @@
 #include "Helper/LineOfSight.h"
 #include "Obstacles/Structures.h"
+#include <algorithm>
 
 namespace LOSHelper {
 
@@ -27,18 +28,49 @@ static inline bool SegmentIntersectsAARect(const Play::Vector2D& a, const Play::
     return true;
 }
 
+// Every structure but the outer wall as a SIMD table, and the StructuresVersion it was built for
+static Geom::BoxTable s_structureTable;
+static std::uint32_t s_builtVersion = 0;
+
+static bool SegmentHitsStructure(const Play::Vector2D& a, const Play::Vector2D& b, const size_t i)
+{
+    const auto &[BottomLeft, Size] = Structures[i];
+    return SegmentIntersectsAARect(a, b, BottomLeft, Size);
+}
+
 bool HasLOS_RawStructures(const Play::Vector2D& a, const Play::Vector2D& b)
 {
     // Use raw structures (non-inflated), skip last (outer wall) if present
     if (Structures.empty()) return true;
+    if (!s_structureTable.empty() && s_builtVersion == StructuresVersion) return !s_structureTable.SegmentHitsAny(a, b);
     for (size_t i = 0; i + 1 < Structures.size(); ++i) {
-        const auto &[BottomLeft, Size] = Structures[i];
-        if (SegmentIntersectsAARect(a, b, BottomLeft, Size)) {
+        if (SegmentHitsStructure(a, b, i)) {
             return false; // blocked
         }
     }
     return true;
 }
 
-} // namespace LOSHelper
+void HasLOS_RawStructures(const std::span<const Geom::Segment> segments, const std::span<std::uint8_t> outClear)
+{
+    const size_t n = std::min(segments.size(), outClear.size());
+    if (!s_structureTable.empty() && s_builtVersion == StructuresVersion) {
+        s_structureTable.SegmentsHitAny(segments.first(n), outClear);
+        for (size_t i = 0; i < n; ++i) outClear[i] ^= 1;
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) outClear[i] = HasLOS_RawStructures(segments[i].a, segments[i].b) ? 1 : 0;
+}
+
+void RebuildStructureTable()
+{
+    std::vector<Geom::Box> boxes;
+    for (size_t i = 0; i + 1 < Structures.size(); ++i) {
+        const auto &[BottomLeft, Size] = Structures[i];
+        boxes.push_back({ BottomLeft.x, BottomLeft.y, BottomLeft.x + Size.x, BottomLeft.y + Size.y });
+    }
+    s_structureTable.Assign(boxes);
+    s_builtVersion = StructuresVersion;
+}
 
+} // namespace LOSHelper
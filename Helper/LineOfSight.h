@@ -2,12 +2,22 @@
 
 /// @brief Line-of-sight utilities.
 
+#include "Helper/BoxTable.h"
 #include <Play.h>
+#include <span>
+#include <cstdint>
 
 namespace LOSHelper {
 
 // Returns true if the segment a->b does NOT intersect any map structures (raw, non-inflated)
 bool HasLOS_RawStructures(const Play::Vector2D& a, const Play::Vector2D& b);
 
+// Batched form: outClear[i] = HasLOS_RawStructures(segments[i].a, segments[i].b)
+void HasLOS_RawStructures(std::span<const Geom::Segment> segments, std::span<std::uint8_t> outClear);
+
+// Rebuilds the SIMD structure table over Structures; call whenever they change (InitStructures does).
+// Until then, and whenever StructuresVersion moved on since, queries test every structure one by one.
+void RebuildStructureTable();
+
 } // namespace LOSHelper
 
@@ -0,0 +1,53 @@
+#include "Helper/RectGrid.h"
+
+namespace Geom {
+
+void RectGrid::Build(const std::span<const Box> boxes, const float cellSize)
+{
+    clear();
+    if (boxes.empty() || cellSize <= 0.0f) return;
+
+    // Grid covers the padded union of the boxes
+    m_originX = m_originY = std::numeric_limits<float>::max();
+    m_maxX = m_maxY = std::numeric_limits<float>::lowest();
+    for (const auto& [minx, miny, maxx, maxy] : boxes) {
+        m_originX = std::min(m_originX, minx - kPad);
+        m_originY = std::min(m_originY, miny - kPad);
+        m_maxX = std::max(m_maxX, maxx + kPad);
+        m_maxY = std::max(m_maxY, maxy + kPad);
+    }
+    m_cellSize = cellSize;
+    m_invCell = 1.0f / cellSize;
+    m_cols = std::max(1, static_cast<int>(std::ceil((m_maxX - m_originX) * m_invCell)));
+    m_rows = std::max(1, static_cast<int>(std::ceil((m_maxY - m_originY) * m_invCell)));
+
+    // Count per cell, prefix-sum, then fill
+    m_ranges.resize(boxes.size());
+    m_cellStart.assign(static_cast<size_t>(m_cols) * m_rows + 1, 0);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const Box& b = boxes[i];
+        CellRange& r = m_ranges[i];
+        r = { cellX(b.minx - kPad), cellY(b.miny - kPad), cellX(b.maxx + kPad), cellY(b.maxy + kPad) };
+        for (int y = r.r0; y <= r.r1; ++y)
+            for (int x = r.c0; x <= r.c1; ++x) ++m_cellStart[y * m_cols + x + 1];
+    }
+    for (size_t c = 1; c < m_cellStart.size(); ++c) m_cellStart[c] += m_cellStart[c - 1];
+
+    m_items.resize(m_cellStart.back());
+    std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const CellRange& r = m_ranges[i];
+        for (int y = r.r0; y <= r.r1; ++y)
+            for (int x = r.c0; x <= r.c1; ++x) m_items[fill[y * m_cols + x]++] = static_cast<int>(i);
+    }
+}
+
+void RectGrid::clear()
+{
+    m_cols = m_rows = 0;
+    m_cellStart.clear();
+    m_items.clear();
+    m_ranges.clear();
+}
+
+} // namespace Geom
@@ -0,0 +1,127 @@
+#pragma once
+
+/// @brief Uniform-grid broadphase over static axis-aligned boxes, walked cell by cell (DDA) for segment queries.
+
+#include <Play.h>
+#include <span>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+namespace Geom {
+
+// Axis-aligned box in world space
+struct Box {
+  float minx{};
+  float miny{};
+  float maxx{};
+  float maxy{};
+};
+
+// Boxes are bucketed into every cell their (slightly padded) bounds overlap, CSR-style. A segment query
+// visits only the cells the segment crosses and offers each box found there once; the caller runs the
+// exact test on the ids (so every user keeps its own touching/epsilon semantics). Read-only after Build,
+// so queries may run concurrently.
+class RectGrid {
+public:
+  void Build(std::span<const Box> boxes, float cellSize);
+  void clear();
+  [[nodiscard]] bool empty() const { return m_cols == 0; }
+
+  // True as soon as test(id) returns true for a box bucketed in a cell the segment a-b crosses
+  template <typename Test>
+  bool AnyOnSegment(const Play::Vector2D& a, const Play::Vector2D& b, Test&& test) const;
+
+  // True as soon as test(id) returns true for a box bucketed in the cell of p
+  template <typename Test>
+  bool AnyAtPoint(const Play::Vector2D& p, Test&& test) const;
+
+private:
+  struct CellRange { int c0, r0, c1, r1; };
+
+  // Boxes are bucketed this much larger than they are, so segments grazing a cell border still
+  // meet the boxes touching it from the other side
+  static constexpr float kPad = 1.0f;
+
+  [[nodiscard]] int cellX(const float x) const { return std::clamp(static_cast<int>(std::floor((x - m_originX) * m_invCell)), 0, m_cols - 1); }
+  [[nodiscard]] int cellY(const float y) const { return std::clamp(static_cast<int>(std::floor((y - m_originY) * m_invCell)), 0, m_rows - 1); }
+
+  float m_cellSize{ 64.0f };
+  float m_invCell{ 1.0f / 64.0f };
+  float m_originX{ 0.0f };
+  float m_originY{ 0.0f };
+  float m_maxX{ 0.0f };
+  float m_maxY{ 0.0f };
+  int m_cols{ 0 };
+  int m_rows{ 0 };
+
+  std::vector<int> m_cellStart{}; // items of cell c are [m_cellStart[c], m_cellStart[c+1])
+  std::vector<int> m_items{};
+  std::vector<CellRange> m_ranges{}; // per box: the cells it is bucketed in
+};
+
+template <typename Test>
+bool RectGrid::AnyOnSegment(const Play::Vector2D& a, const Play::Vector2D& b, Test&& test) const
+{
+  if (empty()) return false;
+
+  // Clip to the grid bounds (nothing is bucketed outside them)
+  const float dx = b.x - a.x, dy = b.y - a.y;
+  float t0 = 0.0f, t1 = 1.0f;
+  auto clip = [&](const float p, const float q) {
+    if (p == 0.0f) return q >= 0.0f;
+    const float t = q / p;
+    if (p < 0.0f) { if (t > t1) return false; t0 = std::max(t0, t); }
+    else          { if (t < t0) return false; t1 = std::min(t1, t); }
+    return true;
+  };
+  if (!clip(-dx, a.x - m_originX) || !clip(dx, m_maxX - a.x) || !clip(-dy, a.y - m_originY) || !clip(dy, m_maxY - a.y)) return false;
+
+  const Play::Vector2D p0{ a.x + dx * t0, a.y + dy * t0 };
+  int cx = cellX(p0.x), cy = cellY(p0.y);
+  const int endX = cellX(a.x + dx * t1), endY = cellY(a.y + dy * t1);
+
+  // Amanatides-Woo stepping in units of the full segment parameter
+  constexpr float inf = std::numeric_limits<float>::infinity();
+  const int stepX = dx > 0.0f ? 1 : dx < 0.0f ? -1 : 0;
+  const int stepY = dy > 0.0f ? 1 : dy < 0.0f ? -1 : 0;
+  const float deltaX = stepX ? m_cellSize / std::abs(dx) : inf;
+  const float deltaY = stepY ? m_cellSize / std::abs(dy) : inf;
+  float nextX = stepX ? (m_originX + static_cast<float>(cx + (stepX > 0)) * m_cellSize - a.x) / dx : inf;
+  float nextY = stepY ? (m_originY + static_cast<float>(cy + (stepY > 0)) * m_cellSize - a.y) / dy : inf;
+
+  int prevX = -1, prevY = -1;
+  for (int guard = m_cols + m_rows; guard >= 0; --guard) {
+    const int cell = cy * m_cols + cx;
+    for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+      // A box also bucketed in the previous cell was offered there already (cells a segment
+      // crosses inside one box's range are consecutive)
+      const int id = m_items[k];
+      const CellRange& r = m_ranges[id];
+      if (prevX >= r.c0 && prevX <= r.c1 && prevY >= r.r0 && prevY <= r.r1) continue;
+      if (test(id)) return true;
+    }
+    if (cx == endX && cy == endY) break;
+
+    prevX = cx;
+    prevY = cy;
+    if (nextX < nextY) { cx += stepX; nextX += deltaX; }
+    else               { cy += stepY; nextY += deltaY; }
+    if (cx < 0 || cy < 0 || cx >= m_cols || cy >= m_rows) break;
+  }
+  return false;
+}
+
+template <typename Test>
+bool RectGrid::AnyAtPoint(const Play::Vector2D& p, Test&& test) const
+{
+  if (empty() || p.x < m_originX || p.y < m_originY || p.x > m_maxX || p.y > m_maxY) return false;
+  const int cell = cellY(p.y) * m_cols + cellX(p.x);
+  for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+    if (test(m_items[k])) return true;
+  }
+  return false;
+}
+
+} // namespace Geom
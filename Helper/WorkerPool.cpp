@@ -0,0 +1,77 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace Threading {
+
+WorkerPool::WorkerPool(unsigned threads)
+{
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    m_threads.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        m_threads.emplace_back([this, slot = i + 1] { WorkerLoop(slot); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_threads) t.join();
+}
+
+void WorkerPool::ParallelFor(const int count, const std::function<void(int, unsigned)>& fn)
+{
+    if (count <= 0) return;
+
+    // Nothing to share: run inline
+    if (m_threads.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) fn(i, 0);
+        return;
+    }
+
+    std::lock_guard call(m_callMutex);
+    {
+        std::lock_guard lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_next = 0;
+        m_busy = Size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    RunJob(0);
+
+    // Every worker checks in, even if the caller already drained the range
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_job = nullptr;
+}
+
+void WorkerPool::WorkerLoop(const unsigned slot)
+{
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+
+        RunJob(slot);
+
+        std::lock_guard lock(m_mutex);
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
+
+void WorkerPool::RunJob(const unsigned slot)
+{
+    for (int i = m_next++; i < m_count; i = m_next++) (*m_job)(i, slot);
+}
+
+} // namespace Threading
@@ -0,0 +1,52 @@
+#pragma once
+
+/// @brief Fixed set of background threads for running data-parallel loops (batched planning etc.).
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+namespace Threading {
+
+// Threads are started once and sleep between jobs. ParallelFor blocks the caller, which also
+// takes part in the work, so a pool of N threads runs a loop on N + 1 threads.
+class WorkerPool {
+public:
+  // threads = 0 picks hardware_concurrency() - 1
+  explicit WorkerPool(unsigned threads = 0);
+  ~WorkerPool();
+
+  // Number of background threads (the caller is slot 0, workers are slots 1..Size())
+  [[nodiscard]] unsigned Size() const { return static_cast<unsigned>(m_threads.size()); }
+
+  // Calls fn(index, slot) for every index in [0, count). 'slot' identifies the executing thread,
+  // so callers can keep per-thread scratch in an array of Size() + 1 entries.
+  // Calls from different threads are serialised.
+  void ParallelFor(int count, const std::function<void(int, unsigned)>& fn);
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+private:
+  void WorkerLoop(unsigned slot);
+  void RunJob(unsigned slot);
+
+  std::vector<std::thread> m_threads{};
+  std::mutex m_callMutex;  // one ParallelFor at a time
+  std::mutex m_mutex;      // guards the job fields below
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+
+  const std::function<void(int, unsigned)>* m_job{ nullptr };
+  int m_count{ 0 };
+  std::atomic<int> m_next{ 0 };
+  unsigned m_busy{ 0 };          // workers that have not finished the current job
+  std::uint64_t m_generation{ 0 };
+  bool m_stop{ false };
+};
+
+} // namespace Threading
@@ -1,6 +1,8 @@
 ﻿#include "Structures.h"
+#include "Helper/LineOfSight.h"
 
 std::vector<Structure> Structures;
+std::uint32_t StructuresVersion = 0;
 
 void InitStructures()
 {
@@ -21,6 +23,8 @@ void InitStructures()
 
     // Outer Wall Box
     Structures.push_back({ {325, 50}, {615, 625} });
+    ++StructuresVersion;
+    LOSHelper::RebuildStructureTable();
 }
 
 void DrawStructures()
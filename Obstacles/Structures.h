@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Play.h"
+#include <cstdint>
 
 struct Structure
 {
@@ -9,6 +10,8 @@ struct Structure
 };
 
 extern std::vector<Structure> Structures;
+// Bump after every change to Structures; data built over them (LOSHelper) is stale once it moves on
+extern std::uint32_t StructuresVersion;
 
 void InitStructures();
 void DrawStructures();
@@ -21,10 +21,11 @@ void MotionService::SetProfile(const MotionConfig& p) { profile_ = p; follower_.
 
 void MotionService::SetCallbacks(const ArrivedCB &onArrived, const BlockedCB &onBlocked) { onArrived_ = onArrived; onBlocked_ = onBlocked; }
 
-void MotionService::FollowPath(const AI::Path& path)
+void MotionService::FollowPath(const AI::Path& path, const std::vector<float>& departures)
 {
   follower_.SetProfile(profile_);
-  follower_.SetPath(path);
+  follower_.SetPath(path, departures);
+  followTime_ = 0.0f;
 
   if (!path.empty())
   {
@@ -38,6 +39,18 @@ void MotionService::FollowPath(const AI::Path& path)
   if (tank_) lastProgressPos_ = tank_->GetPosition();
 }
 
+void MotionService::ReplacePath(const AI::Path& path)
+{
+  if (!follower_.HasPath() || path.empty())
+  {
+    FollowPath(path);
+    return;
+  }
+
+  follower_.ReplacePath(path);
+  currentGoal_ = path.back();
+}
+
 void MotionService::CancelFollow()
 {
   follower_.Cancel();
@@ -73,8 +86,9 @@ void MotionService::Tick(const float dt, const AI::SelfState& self)
   if (!tank_) return;
 
   soundTimer_ += dt;
+  followTime_ += dt;
 
-  const auto [move, rotate, status, lookahead] = follower_.Tick(self);
+  const auto [move, rotate, status, lookahead] = follower_.Tick(self, followTime_);
   lastLookahead_ = follower_.HasPath() ? std::optional<Play::Vector2D>(lookahead) : std::nullopt;
 
   float final_rotate_command = rotate; // Default to path follower's rotation
@@ -28,9 +28,17 @@ public:
   void SetSoundEmitter(const SoundEmitCB& cb) { soundEmit_ = cb; }
 
   // High level operations
-  void FollowPath(const AI::Path& path);
+  // 'departures' (optional): seconds after this call before which path[i] may not be left
+  void FollowPath(const AI::Path& path, const std::vector<float>& departures = {});
   void CancelFollow();
 
+  // Updates the path being followed (e.g. a moved goal or repaired tail) without restarting the
+  // follow: alignment, status and stuck tracking carry over. Falls back to FollowPath when idle.
+  void ReplacePath(const AI::Path& path);
+  [[nodiscard]] const AI::Path& GetPath() const { return follower_.GetPath(); }
+  // Seconds since the current path was issued with FollowPath
+  [[nodiscard]] float GetFollowTime() const { return followTime_; }
+
   // Low level controls
   void Move(int intent) const;       // intent: -1 (backward), +1 (forward)
   void Rotate(int intent) const;     // intent: -1 (counterclockwise), +1 (clockwise)
@@ -62,6 +70,7 @@ private:
   PathFollower follower_{};
   Play::Vector2D currentGoal_{};
   FollowCommand::Status lastStatus_{ FollowCommand::Status::Idle };
+  float followTime_{0.0f};
 
   // Aiming State
   std::optional<Play::Vector2D> aimTarget_{};
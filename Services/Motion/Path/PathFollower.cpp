@@ -76,22 +76,41 @@ static Play::Vector2D AdvanceAlongPolyline(const AI::Path& poly, const int seg,
   return poly.back();
 }
 
-void PathFollower::SetPath(const AI::Path& p)
+void PathFollower::SetPath(const AI::Path& p, const std::vector<float>& departures)
 {
   path_ = p;
+  departures_ = departures;
   currentSegmentIndex_ = 0;
   initialAlign_ = true; // enable one-time pre-alignment
 }
 
+void PathFollower::ReplacePath(const AI::Path& p)
+{
+  path_ = p;
+  departures_.clear();
+  currentSegmentIndex_ = std::min(currentSegmentIndex_, path_.empty() ? 0 : path_.size() - 1);
+}
+
 bool PathFollower::HasPath() const { return !path_.empty(); }
 
 void PathFollower::Cancel()
 {
   path_.clear();
+  departures_.clear();
   currentSegmentIndex_ = 0;
 }
 
-FollowCommand PathFollower::Tick(const AI::SelfState& self)
+bool PathFollower::MustWait_(const AI::SelfState& self, const std::size_t segIdx, const float elapsed) const
+{
+  // The waypoint just passed or the next one, whichever the tank is standing at
+  const float holdTol = std::max(profile_.arrive_tol_px, self.radius);
+  for (std::size_t i = segIdx; i <= segIdx + 1 && i < departures_.size(); ++i) {
+    if (elapsed < departures_[i] && Geom::dist(self.pos, path_[i]) <= holdTol) return true;
+  }
+  return false;
+}
+
+FollowCommand PathFollower::Tick(const AI::SelfState& self, const float elapsed)
 {
   FollowCommand cmd;
 
@@ -174,12 +193,13 @@ FollowCommand PathFollower::Tick(const AI::SelfState& self)
   cmd.lookahead = look;
 
   // Steering: rotate at most one step in the needed direction, always try move forward one step
+  // (unless a cooperative schedule says to wait here; turning towards the path is still fine)
   if (std::fabs(alpha) > profile_.ang_tol) {
     cmd.rotate = (alpha > 0.0f ? -profile_.w_step : +profile_.w_step);
   } else {
     cmd.rotate = 0.0f;
   }
-  cmd.move = profile_.v_step;
+  cmd.move = MustWait_(self, static_cast<std::size_t>(segIdx), elapsed) ? 0.0f : profile_.v_step;
 
   cmd.status = FollowCommand::Status::Following;
   return cmd;
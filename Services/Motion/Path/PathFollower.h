@@ -10,14 +10,23 @@ namespace Motion
 class PathFollower {
 public:
   void SetProfile(const MotionConfig& p) { profile_ = p; }
-  void SetPath(const AI::Path& p);
+  // 'departures' (optional, seconds since SetPath) holds the tank at path[i] until departures[i]
+  void SetPath(const AI::Path& p, const std::vector<float>& departures = {});
+  // Swaps in an edited version of the current path; alignment state carries over, the schedule does not
+  void ReplacePath(const AI::Path& p);
+  [[nodiscard]] const AI::Path& GetPath() const { return path_; }
   [[nodiscard]] bool HasPath() const;
   void Cancel();
-  FollowCommand Tick(const AI::SelfState& self);
+  // 'elapsed': seconds since SetPath (only read against the departure schedule)
+  FollowCommand Tick(const AI::SelfState& self, float elapsed = 0.0f);
 
 private:
+  // A scheduled waypoint next to the tank that may not be left yet
+  [[nodiscard]] bool MustWait_(const AI::SelfState& self, std::size_t segIdx, float elapsed) const;
+
   MotionConfig profile_{};
   AI::Path path_{};
+  std::vector<float> departures_{};
 
   // Internal state
   std::size_t currentSegmentIndex_{0}; // index i means segment from path[i] to path[i+1]
@@ -35,7 +35,8 @@ struct FollowCommand {
     Idle,
     Following,
     Arrived,
-    Blocked
+    Blocked,
+    Pending   // a move was requested and its path is still being planned (reported by the AI gateway)
   };
   Status status{Status::Idle};
   Play::Vector2D lookahead{};
@@ -1,74 +1,156 @@
 #include "AStar.h"
 #include "Pathfinding/Graph/Graph.h"
+#include "Pathfinding/Graph/GraphOverlay.h"
+#include "SearchContext.h"
+#include "SearchCore.h"
+#include "Pathfinding/Tactical/CostLayers.h"
 #include <vector>
-#include <queue>
-#include <limits>
+#include <type_traits>
 #include "Helper/Geometry.h"
 
 namespace Pathfinding {
 
-bool FindPath(const Graph& g, const int startNode, const int goalNode, std::vector<int>& outPath, float* outCost)
-{
-  outPath.clear();
-  const int N = g.size();
-  if (N <= 0) return false;
-  if (startNode < 0 || goalNode < 0 || startNode >= N || goalNode >= N) return false;
-  if (startNode == goalNode) {
-    outPath.push_back(startNode);
-    return true;
+namespace {
+
+// Adapts the plain graph to the view interface used by the search (size/pos/forEachNeighbor)
+struct BaseGraphView {
+  const Graph& g;
+
+  [[nodiscard]] int size() const { return g.size(); }
+  [[nodiscard]] Play::Vector2D pos(const int n) const { return g.pos(n); }
+
+  template <typename Fn>
+  void forEachNeighbor(const int u, Fn&& fn) const {
+    for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) fn(g.edgeTarget(e), g.edgeCost(e));
   }
+};
 
-  // Node entry stored in the open priority queue: node id and its f = g + h value
-  struct Rec { int node; float f; };
-  // Min-heap comparator (priority_queue is max-heap by default)
-  auto cmp = [](const Rec& a, const Rec& b){ return a.f > b.f; };
-  std::priority_queue<Rec, std::vector<Rec>, decltype(cmp)> open(cmp);
-
-  // Cost from start to node (g), estimated total cost (f), and bookkeeping
-  std::vector<float> gScore(N, std::numeric_limits<float>::infinity());
-  std::vector<float> fScore(N, std::numeric_limits<float>::infinity());
-  std::vector<int> cameFrom(N, -1);      // predecessor for path reconstruction
-  std::vector<char> closed(N, 0);        // closed set marker (visited/expanded)
-
-  // Heuristic: Euclidean distance from node n to the goal node (uses shared dist())
-  auto h = [&](const int n){ return Geom::dist(g.nodes()[n].pos, g.nodes()[goalNode].pos); };
-
-  // Initialize start node
-  gScore[startNode] = 0.0f;
-  fScore[startNode] = h(startNode);
-  open.push({ startNode, fScore[startNode] });
-
-  // Main A* loop
-  while (!open.empty()) {
-    // Pop the node with lowest f (note: entries can be stale; check closed[])
-    const int current = open.top().node; open.pop();
-    if (closed[current]) continue;       // already expanded with a better score
-    closed[current] = 1;
-
-    // If we reached the goal, reconstruct path by following cameFrom
-    if (current == goalNode) {
-      int n = current;
-      while (n != -1) { outPath.push_back(n); n = cameFrom[n]; }
-      std::ranges::reverse(outPath);
-      if (outCost) *outCost = gScore[goalNode];
-      return true;
-    }
+// Base graph restricted to one region (e.g. an HPA* cluster); edges leaving it are ignored
+struct RegionGraphView {
+  const Graph& g;
+  const std::vector<int>& regionOf;
+  int region;
+
+  [[nodiscard]] int size() const { return g.size(); }
+  [[nodiscard]] Play::Vector2D pos(const int n) const { return g.pos(n); }
 
-    // Relax neighbors
-    for (const auto &[to, cost] : g.nodes()[current].edges) {
-      const int nb = to;
-      if (closed[nb]) continue;          // skip already expanded neighbor
-
-      const float tentative = gScore[current] + cost;
-      // Found a better path to neighbor
-      if (tentative < gScore[nb]) {
-        cameFrom[nb] = current;
-        gScore[nb] = tentative;
-        fScore[nb] = tentative + h(nb);
-        open.push({ nb, fScore[nb] });  // push new entry
-      }
+  template <typename Fn>
+  void forEachNeighbor(const int u, Fn&& fn) const {
+    for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+      const int v = g.edgeTarget(e);
+      if (regionOf[v] == region) fn(v, g.edgeCost(e));
     }
   }
-  return false; // no path found
+};
+
+// Overlay edge costs plus the danger of the underlying base edge (split stretches pay their share)
+struct TacticalEdgeCost {
+  const GraphOverlay& overlay;
+  const CostLayers& layers;
+  std::uint32_t mask;
+  const std::unordered_map<int, float>& excluded;
+
+  [[nodiscard]] float extra(const int e) const {
+    float d = layers.Extra(e, mask);
+    if (!excluded.empty())
+      if (const auto it = excluded.find(e); it != excluded.end()) d = std::max(0.0f, d - it->second);
+    return d;
+  }
+
+  [[nodiscard]] float operator()(const int u, const int v, const float cost) const {
+    const Graph& g = overlay.base();
+    int a, b;
+    if (!overlay.splitEdge(u, a, b) && !overlay.splitEdge(v, a, b)) return cost + extra(g.findEdge(u, v));
+
+    const float length = Geom::dist(g.pos(a), g.pos(b));
+    if (length <= 0.0f) return cost;
+    return cost + extra(g.findEdge(a, b)) * Geom::dist(overlay.pos(u), overlay.pos(v)) / length;
+  }
+};
+
+} // namespace
+
+// Open list of the planner's searches, chosen at compile time (TANKAI_NAV_OPEN_LIST in CMake)
+#if defined(TANKAI_NAV_OPEN_LIST_PAIRING)
+using NavOpenList = PairingHeapOpenList;
+#elif defined(TANKAI_NAV_OPEN_LIST_RADIX)
+using NavOpenList = RadixOpenList;
+#else
+using NavOpenList = ContextOpenList;
+#endif
+
+// The default heap lives in the SearchContext; standalone lists are kept per thread (one per Slot)
+template <int Slot>
+static decltype(auto) NavOpen(SearchContext& ctx)
+{
+  if constexpr (std::is_same_v<NavOpenList, ContextOpenList>) {
+    return ContextOpenList(ctx);
+  } else {
+    thread_local NavOpenList open;
+    return (open);
+  }
+}
+
+template <typename View>
+static bool FindPathImpl(const View& g, const int startNode, const int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost)
+{
+  auto&& open = NavOpen<0>(ctx);
+  return AStarSearch(g, startNode, goalNode, ctx, open, outPath, outCost);
+}
+
+template <typename View>
+static bool FindPathBidirectionalImpl(const View& g, const int startNode, const int goalNode, SearchContext& fwd, SearchContext& bwd, std::vector<int>& outPath, float* outCost)
+{
+  auto&& openFwd = NavOpen<0>(fwd);
+  auto&& openBwd = NavOpen<1>(bwd);
+  return BidirectionalSearch(g, startNode, goalNode, fwd, bwd, openFwd, openBwd, outPath, outCost);
+}
+
+bool FindPath(const Graph& g, const int startNode, const int goalNode, std::vector<int>& outPath, float* outCost)
+{
+  SearchContext ctx;
+  return FindPathImpl(BaseGraphView{ g }, startNode, goalNode, ctx, outPath, outCost);
+}
+
+bool FindPath(const GraphOverlay& overlay, const int startNode, const int goalNode, std::vector<int>& outPath, float* outCost)
+{
+  SearchContext ctx;
+  return FindPathImpl(overlay, startNode, goalNode, ctx, outPath, outCost);
+}
+
+bool FindPath(const Graph& g, const int startNode, const int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost)
+{
+  return FindPathImpl(BaseGraphView{ g }, startNode, goalNode, ctx, outPath, outCost);
+}
+
+bool FindPath(const GraphOverlay& overlay, const int startNode, const int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost)
+{
+  return FindPathImpl(overlay, startNode, goalNode, ctx, outPath, outCost);
+}
+
+bool FindPathInRegion(const Graph& g, const std::vector<int>& regionOf, const int region, const int startNode, const int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost)
+{
+  if (startNode < 0 || goalNode < 0 || startNode >= g.size() || goalNode >= g.size()) { outPath.clear(); return false; }
+  if (regionOf[startNode] != region || regionOf[goalNode] != region) { outPath.clear(); return false; }
+  return FindPathImpl(RegionGraphView{ g, regionOf, region }, startNode, goalNode, ctx, outPath, outCost);
+}
+
+bool FindPathTactical(const GraphOverlay& overlay, const int startNode, const int goalNode, const CostLayers& layers, const std::uint32_t layerMask,
+                      const std::unordered_map<int, float>& excluded, SearchContext& ctx, std::vector<int>& outPath, float* outCost)
+{
+  // Danger costs are non-negative, so straight-line distance still bounds the remaining cost
+  auto&& open = NavOpen<0>(ctx);
+  return AStarSearch(overlay, startNode, goalNode, ctx, open, outPath, outCost, EuclideanHeuristic{},
+                     TacticalEdgeCost{ overlay, layers, layerMask, excluded });
+}
+
+bool FindPathBidirectional(const Graph& g, const int startNode, const int goalNode, SearchContext& fwd, SearchContext& bwd, std::vector<int>& outPath, float* outCost)
+{
+  return FindPathBidirectionalImpl(BaseGraphView{ g }, startNode, goalNode, fwd, bwd, outPath, outCost);
+}
+
+bool FindPathBidirectional(const GraphOverlay& overlay, const int startNode, const int goalNode, SearchContext& fwd, SearchContext& bwd, std::vector<int>& outPath, float* outCost)
+{
+  return FindPathBidirectionalImpl(overlay, startNode, goalNode, fwd, bwd, outPath, outCost);
 }
-} // namespace Pathfinding
\ No newline at end of file
+} // namespace Pathfinding
@@ -1,14 +1,42 @@
 #pragma once
 
-/// @brief Implements A* pathfinding algorithm on a graph.
+/// @brief Implements A* pathfinding algorithm on a graph (instantiations of the templated core in SearchCore.h).
 
 #include <vector>
+#include <unordered_map>
+#include <cstdint>
 
 namespace Pathfinding {
 class Graph;
+class GraphOverlay;
+class SearchContext;
+class CostLayers;
 
 // Compute a path as a sequence of node indices from 'startNode' to 'goalNode'.
 // Returns true if a path is found. 'outPath' is cleared and filled on success.
 bool FindPath(const Graph& g, int startNode, int goalNode, std::vector<int>& outPath, float* outCost = nullptr);
 
+// Same as above, but searches the base graph plus the overlay's temporary endpoint nodes.
+// Node ids in 'outPath' may refer to virtual overlay nodes (>= base size).
+bool FindPath(const GraphOverlay& overlay, int startNode, int goalNode, std::vector<int>& outPath, float* outCost = nullptr);
+
+// Overloads that reuse a caller-owned SearchContext, so repeated queries are allocation-free
+// once its buffers have grown to the graph size.
+bool FindPath(const Graph& g, int startNode, int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost = nullptr);
+bool FindPath(const GraphOverlay& overlay, int startNode, int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost = nullptr);
+
+// Bidirectional variant (two searches meeting in the middle); same result cost as FindPath, fewer
+// expansions on long open paths. Needs a second context for the backward search.
+bool FindPathBidirectional(const Graph& g, int startNode, int goalNode, SearchContext& fwd, SearchContext& bwd, std::vector<int>& outPath, float* outCost = nullptr);
+bool FindPathBidirectional(const GraphOverlay& overlay, int startNode, int goalNode, SearchContext& fwd, SearchContext& bwd, std::vector<int>& outPath, float* outCost = nullptr);
+
+// Overlay search with the danger costs of the layers in 'layerMask' added to every edge (split edges
+// get their share by length). 'excluded' holds per-edge costs to take back out (e.g. the searching
+// tank's own sight cone, see CostLayers::OwnerContributions). outCost includes the danger costs.
+bool FindPathTactical(const GraphOverlay& overlay, int startNode, int goalNode, const CostLayers& layers, std::uint32_t layerMask,
+                      const std::unordered_map<int, float>& excluded, SearchContext& ctx, std::vector<int>& outPath, float* outCost = nullptr);
+
+// Search confined to the nodes n with regionOf[n] == region (both endpoints must be inside it).
+bool FindPathInRegion(const Graph& g, const std::vector<int>& regionOf, int region, int startNode, int goalNode, SearchContext& ctx, std::vector<int>& outPath, float* outCost = nullptr);
+
 } // namespace Pathfinding
@@ -0,0 +1,79 @@
+#pragma once
+
+/// @brief Reusable scratch state for A* searches; owned per agent (or per thread) and reused across queries.
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+namespace Pathfinding {
+
+// Per-node bookkeeping is stamped with a generation counter instead of being cleared,
+// so starting a new search is O(1) and a query only touches the nodes it visits.
+// Buffers grow to the largest graph seen and are never shrunk.
+class SearchContext {
+public:
+  // Node entry stored in the open list: node id and its f = g + h value
+  struct OpenRec { int node; float f; };
+
+  // Prepares for a search over 'nodeCount' nodes (invalidates all previous state)
+  void begin(const int nodeCount) {
+    if (static_cast<int>(m_seen.size()) < nodeCount) {
+      m_seen.resize(nodeCount, 0);
+      m_closed.resize(nodeCount, 0);
+      m_g.resize(nodeCount);
+      m_cameFrom.resize(nodeCount);
+    }
+    if (++m_generation == 0) {
+      // Wrapped around: old stamps could alias the new generation, so clear once
+      std::ranges::fill(m_seen, 0u);
+      std::ranges::fill(m_closed, 0u);
+      m_generation = 1;
+    }
+    m_open.clear();
+  }
+
+  [[nodiscard]] float gScore(const int n) const {
+    return m_seen[n] == m_generation ? m_g[n] : std::numeric_limits<float>::infinity();
+  }
+  [[nodiscard]] int cameFrom(const int n) const { return m_seen[n] == m_generation ? m_cameFrom[n] : -1; }
+
+  void setScore(const int n, const float g, const int from) {
+    m_seen[n] = m_generation;
+    m_g[n] = g;
+    m_cameFrom[n] = from;
+  }
+
+  [[nodiscard]] bool isClosed(const int n) const { return m_closed[n] == m_generation; }
+  void close(const int n) { m_closed[n] = m_generation; }
+
+  // Open list as a min-heap on f (entries can be stale; check isClosed())
+  void pushOpen(const int n, const float f) {
+    m_open.push_back({ n, f });
+    std::ranges::push_heap(m_open, greaterF);
+  }
+  [[nodiscard]] bool openEmpty() const { return m_open.empty(); }
+  OpenRec popOpen() {
+    std::ranges::pop_heap(m_open, greaterF);
+    const OpenRec top = m_open.back();
+    m_open.pop_back();
+    return top;
+  }
+
+  // Scratch buffer for node-index paths, reused by callers that only need them temporarily
+  std::vector<int>& scratchPath() { return m_path; }
+
+private:
+  static bool greaterF(const OpenRec& a, const OpenRec& b) { return a.f > b.f; }
+
+  std::uint32_t m_generation{ 0 };
+  std::vector<std::uint32_t> m_seen{};   // generation in which g/cameFrom were written
+  std::vector<std::uint32_t> m_closed{}; // generation in which the node was expanded
+  std::vector<float> m_g{};
+  std::vector<int> m_cameFrom{};
+  std::vector<OpenRec> m_open{};
+  std::vector<int> m_path{};
+};
+
+} // namespace Pathfinding
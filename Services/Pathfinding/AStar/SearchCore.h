@@ -0,0 +1,148 @@
+#pragma once
+
+/// @brief Templated A* core (unidirectional and bidirectional) parameterised on heuristic, edge cost and open list.
+
+#include "SearchContext.h"
+#include "SearchPolicies.h"
+#include <vector>
+#include <algorithm>
+
+namespace Pathfinding {
+
+// A View is anything with size(), pos(n) and forEachNeighbor(u, fn(v, cost)) (Graph views,
+// GraphOverlay). Instantiating with different policies gives separate, fully inlined searches;
+// see AStar.cpp for the ones the planner uses.
+
+// Single-direction A*. Same contract as FindPath: outPath is cleared, filled start..goal on success.
+template <typename View, typename OpenList, typename Heuristic = EuclideanHeuristic, typename Cost = GraphEdgeCost>
+bool AStarSearch(const View& g, const int startNode, const int goalNode, SearchContext& ctx, OpenList& open,
+                 std::vector<int>& outPath, float* outCost, const Heuristic& heuristic = {}, const Cost& edgeCost = {})
+{
+  outPath.clear();
+  const int N = g.size();
+  if (N <= 0) return false;
+  if (startNode < 0 || goalNode < 0 || startNode >= N || goalNode >= N) return false;
+  if (startNode == goalNode) {
+    outPath.push_back(startNode);
+    if (outCost) *outCost = 0.0f;
+    return true;
+  }
+
+  // Cost from start (g), predecessors and closed set live in the reusable context
+  ctx.begin(N);
+  open.clear();
+
+  const Play::Vector2D goalPos = g.pos(goalNode);
+  auto h = [&](const int n) { return heuristic(g.pos(n), goalPos); };
+
+  ctx.setScore(startNode, 0.0f, -1);
+  open.push(startNode, h(startNode));
+
+  while (!open.empty()) {
+    // Pop the node with lowest f (entries can be stale; check closed)
+    const int current = open.pop().node;
+    if (ctx.isClosed(current)) continue;
+    ctx.close(current);
+
+    if (current == goalNode) {
+      for (int n = current; n != -1; n = ctx.cameFrom(n)) outPath.push_back(n);
+      std::ranges::reverse(outPath);
+      if (outCost) *outCost = ctx.gScore(goalNode);
+      return true;
+    }
+
+    const float gCurrent = ctx.gScore(current);
+    g.forEachNeighbor(current, [&](const int nb, const float cost) {
+      if (ctx.isClosed(nb)) return;
+      const float tentative = gCurrent + edgeCost(current, nb, cost);
+      if (tentative < ctx.gScore(nb)) {
+        ctx.setScore(nb, tentative, current);
+        open.push(nb, tentative + h(nb));
+      }
+    });
+  }
+  return false;
+}
+
+// Bidirectional A*: a forward search from the start and a backward one from the goal, each with its
+// own context and open list, expanding whichever side has the smaller key. Stops once the best
+// meeting cost found is no larger than the larger of the two open minima (Pohl's criterion), so the
+// result is optimal for admissible heuristics. Requires symmetric edge costs (the nav graph is undirected).
+template <typename View, typename OpenList, typename Heuristic = EuclideanHeuristic, typename Cost = GraphEdgeCost>
+bool BidirectionalSearch(const View& g, const int startNode, const int goalNode, SearchContext& fwd, SearchContext& bwd,
+                         OpenList& openFwd, OpenList& openBwd, std::vector<int>& outPath, float* outCost,
+                         const Heuristic& heuristic = {}, const Cost& edgeCost = {})
+{
+  outPath.clear();
+  const int N = g.size();
+  if (N <= 0) return false;
+  if (startNode < 0 || goalNode < 0 || startNode >= N || goalNode >= N) return false;
+  if (startNode == goalNode) {
+    outPath.push_back(startNode);
+    if (outCost) *outCost = 0.0f;
+    return true;
+  }
+
+  fwd.begin(N);
+  bwd.begin(N);
+  openFwd.clear();
+  openBwd.clear();
+
+  const Play::Vector2D startPos = g.pos(startNode), goalPos = g.pos(goalNode);
+  fwd.setScore(startNode, 0.0f, -1);
+  openFwd.push(startNode, heuristic(startPos, goalPos));
+  bwd.setScore(goalNode, 0.0f, -1);
+  openBwd.push(goalNode, heuristic(goalPos, startPos));
+
+  float best = kBlockedCost; // cheapest start-goal path through a node both sides reached
+  int meet = -1;
+
+  // Pops stale entries until a live one comes up and holds that entry in outTop, off the heap, as the
+  // side's lower bound and its next node to expand
+  auto settleTop = [](SearchContext& ctx, OpenList& open, OpenRec& outTop) {
+    while (!open.empty()) {
+      outTop = open.pop();
+      if (!ctx.isClosed(outTop.node)) return true;
+    }
+    return false;
+  };
+
+  OpenRec topF{}, topB{};
+  bool hasF = settleTop(fwd, openFwd, topF), hasB = settleTop(bwd, openBwd, topB);
+  while (hasF && hasB) {
+    if (best <= std::max(topF.f, topB.f)) break;
+
+    // Expand the side with the smaller key; its popped top is the node to expand
+    const bool forward = topF.f <= topB.f;
+    SearchContext& ctx = forward ? fwd : bwd;
+    SearchContext& other = forward ? bwd : fwd;
+    OpenList& open = forward ? openFwd : openBwd;
+    const Play::Vector2D target = forward ? goalPos : startPos;
+    const int current = (forward ? topF : topB).node;
+    ctx.close(current);
+
+    const float gCurrent = ctx.gScore(current);
+    g.forEachNeighbor(current, [&](const int nb, const float cost) {
+      if (ctx.isClosed(nb)) return;
+      const float tentative = gCurrent + (forward ? edgeCost(current, nb, cost) : edgeCost(nb, current, cost));
+      if (!(tentative < ctx.gScore(nb))) return;
+      ctx.setScore(nb, tentative, current);
+      open.push(nb, tentative + heuristic(g.pos(nb), target));
+      if (const float through = tentative + other.gScore(nb); through < best) { best = through; meet = nb; }
+    });
+    if (const float through = gCurrent + other.gScore(current); through < best) { best = through; meet = current; }
+
+    if (forward) hasF = settleTop(fwd, openFwd, topF);
+    else         hasB = settleTop(bwd, openBwd, topB);
+  }
+  if (meet < 0) return false;
+
+  // Start .. meet from the forward tree, then meet .. goal from the backward one
+  for (int n = meet; n != -1; n = fwd.cameFrom(n)) outPath.push_back(n);
+  std::ranges::reverse(outPath);
+  for (int n = bwd.cameFrom(meet); n != -1; n = bwd.cameFrom(n)) outPath.push_back(n);
+  if (outCost) *outCost = best;
+  return true;
+}
+
+} // namespace Pathfinding
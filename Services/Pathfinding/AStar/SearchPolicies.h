@@ -0,0 +1,167 @@
+#pragma once
+
+/// @brief Compile-time policies for the search core: heuristics, edge-cost functions and open lists.
+
+#include "SearchContext.h"
+#include "Helper/Geometry.h"
+#include <Play.h>
+#include <vector>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace Pathfinding {
+
+// ---- Heuristics: float operator()(from, to) returning a lower bound on the cost between the points ----
+
+// Straight-line distance; admissible and consistent while edge costs are at least their length
+struct EuclideanHeuristic {
+  [[nodiscard]] float operator()(const Play::Vector2D& a, const Play::Vector2D& b) const { return Geom::dist(a, b); }
+};
+
+// No guidance: the search degenerates to Dijkstra
+struct ZeroHeuristic {
+  [[nodiscard]] float operator()(const Play::Vector2D&, const Play::Vector2D&) const { return 0.0f; }
+};
+
+// ---- Edge costs: float operator()(u, v, edgeCost) giving the cost the search uses for u -> v ----
+
+// The graph's own costs
+struct GraphEdgeCost {
+  [[nodiscard]] float operator()(int, int, const float cost) const { return cost; }
+};
+
+// ---- Open lists: push(node, key), pop() -> OpenRec with the smallest key, empty(), clear() ----
+// All of them allow duplicate entries for a node (no decrease-key); the search skips the stale ones.
+
+using OpenRec = SearchContext::OpenRec;
+
+// The binary heap kept inside the SearchContext (what FindPath has always used)
+class ContextOpenList {
+public:
+  explicit ContextOpenList(SearchContext& ctx) : m_ctx(ctx) {}
+
+  void clear() {} // SearchContext::begin clears it
+  void push(const int node, const float key) { m_ctx.pushOpen(node, key); }
+  [[nodiscard]] bool empty() const { return m_ctx.openEmpty(); }
+  OpenRec pop() { return m_ctx.popOpen(); }
+
+private:
+  SearchContext& m_ctx;
+};
+
+// Standalone binary heap (for searches that need more than one open list per context)
+class BinaryHeapOpenList {
+public:
+  void clear() { m_heap.clear(); }
+  void push(const int node, const float key) {
+    m_heap.push_back({ node, key });
+    std::ranges::push_heap(m_heap, greater);
+  }
+  [[nodiscard]] bool empty() const { return m_heap.empty(); }
+  OpenRec pop() {
+    std::ranges::pop_heap(m_heap, greater);
+    const OpenRec top = m_heap.back();
+    m_heap.pop_back();
+    return top;
+  }
+
+private:
+  static bool greater(const OpenRec& a, const OpenRec& b) { return a.f > b.f; }
+  std::vector<OpenRec> m_heap{};
+};
+
+// Pairing heap over a reusable node pool: O(1) push, amortised O(log n) pop
+class PairingHeapOpenList {
+public:
+  void clear() { m_pool.clear(); m_root = -1; }
+  void push(const int node, const float key) {
+    m_pool.push_back({ { node, key }, -1, -1 });
+    m_root = meld(m_root, static_cast<int>(m_pool.size()) - 1);
+  }
+  [[nodiscard]] bool empty() const { return m_root < 0; }
+  OpenRec pop() {
+    const OpenRec top = m_pool[m_root].rec;
+
+    // Two-pass merge of the root's children: pairs left to right, then fold right to left
+    m_pairs.clear();
+    for (int c = m_pool[m_root].child; c >= 0;) {
+      const int a = c, b = m_pool[a].sibling;
+      c = b >= 0 ? m_pool[b].sibling : -1;
+      m_pool[a].sibling = -1;
+      if (b >= 0) m_pool[b].sibling = -1;
+      m_pairs.push_back(meld(a, b));
+    }
+    int root = -1;
+    for (auto it = m_pairs.rbegin(); it != m_pairs.rend(); ++it) root = meld(root, *it);
+    m_root = root;
+    if (m_root < 0) m_pool.clear(); // drained: recycle the pool
+    return top;
+  }
+
+private:
+  struct Item { OpenRec rec; int child; int sibling; };
+
+  int meld(const int a, const int b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    const int parent = m_pool[a].rec.f <= m_pool[b].rec.f ? a : b;
+    const int child = parent == a ? b : a;
+    m_pool[child].sibling = m_pool[parent].child;
+    m_pool[parent].child = child;
+    return parent;
+  }
+
+  std::vector<Item> m_pool{};
+  std::vector<int> m_pairs{};
+  int m_root{ -1 };
+};
+
+// Radix heap on the bit patterns of the (non-negative) keys: O(1) push, amortised O(log C) pop.
+// Keys must never drop below the last popped one, which holds for A* with a consistent heuristic;
+// keys that do (float rounding) are raised to it.
+class RadixOpenList {
+public:
+  void clear() {
+    for (auto& b : m_buckets) b.clear();
+    m_size = 0;
+    m_last = 0;
+  }
+  void push(const int node, const float key) {
+    const std::uint32_t bits = std::max(toBits(key), m_last);
+    m_buckets[bucketOf(bits)].push_back({ node, bits });
+    ++m_size;
+  }
+  [[nodiscard]] bool empty() const { return m_size == 0; }
+  OpenRec pop() {
+    if (m_buckets[0].empty()) {
+      // Smallest key of the first non-empty bucket becomes the new reference; redistribute around it
+      size_t i = 1;
+      while (m_buckets[i].empty()) ++i;
+      auto& source = m_buckets[i];
+      m_last = std::ranges::min_element(source, {}, &Entry::bits)->bits;
+      for (const Entry& e : source) m_buckets[bucketOf(e.bits)].push_back(e);
+      source.clear();
+    }
+    const Entry top = m_buckets[0].back();
+    m_buckets[0].pop_back();
+    --m_size;
+    return { top.node, fromBits(top.bits) };
+  }
+
+private:
+  struct Entry { int node; std::uint32_t bits; };
+
+  // IEEE-754 order matches unsigned order for non-negative floats
+  static std::uint32_t toBits(const float f) { std::uint32_t b; std::memcpy(&b, &f, sizeof(b)); return b; }
+  static float fromBits(const std::uint32_t b) { float f; std::memcpy(&f, &b, sizeof(f)); return f; }
+  [[nodiscard]] size_t bucketOf(const std::uint32_t bits) const { return static_cast<size_t>(std::bit_width(bits ^ m_last)); }
+
+  std::array<std::vector<Entry>, 33> m_buckets{};
+  size_t m_size{ 0 };
+  std::uint32_t m_last{ 0 };
+};
+
+} // namespace Pathfinding
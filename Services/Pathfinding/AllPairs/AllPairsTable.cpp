@@ -0,0 +1,101 @@
+#include "AllPairsTable.h"
+#include "Pathfinding/Graph/Graph.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <queue>
+
+namespace Pathfinding {
+
+// Graphs below this size are built on the calling thread; spawning workers costs more than it saves
+static constexpr int kParallelMinNodes = 64;
+
+std::size_t AllPairsTable::BytesFor(const int nodeCount)
+{
+    const auto n = static_cast<std::size_t>(std::max(0, nodeCount));
+    return n * n * (sizeof(float) + sizeof(int));
+}
+
+void AllPairsTable::clear()
+{
+    m_n = 0;
+    m_dist.clear();
+    m_next.clear();
+}
+
+bool AllPairsTable::Build(const Graph& g, const std::size_t budgetBytes)
+{
+    clear();
+    const int N = g.size();
+    if (N == 0 || BytesFor(N) > budgetBytes) return false;
+
+    m_n = N;
+    m_dist.assign(static_cast<std::size_t>(N) * N, kUnreachable);
+    m_next.assign(static_cast<std::size_t>(N) * N, -1);
+
+    // One Dijkstra rooted at 'source' fills column 'source': on an undirected graph the
+    // parent of v in the tree rooted at source is v's next hop towards source.
+    auto dijkstraColumn = [&](const int source, std::vector<float>& dist, std::vector<int>& parent) {
+        struct Rec { int node; float d; };
+        auto cmp = [](const Rec& a, const Rec& b){ return a.d > b.d; };
+        std::priority_queue<Rec, std::vector<Rec>, decltype(cmp)> open(cmp);
+
+        std::ranges::fill(dist, kUnreachable);
+        std::ranges::fill(parent, -1);
+        dist[source] = 0.0f;
+        open.push({ source, 0.0f });
+
+        while (!open.empty()) {
+            const auto [u, d] = open.top(); open.pop();
+            if (d > dist[u]) continue; // stale entry
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                const int v = g.edgeTarget(e);
+                const float nd = d + g.edgeCost(e);
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    open.push({ v, nd });
+                }
+            }
+        }
+
+        for (int v = 0; v < N; ++v) {
+            const std::size_t cell = static_cast<std::size_t>(v) * N + source;
+            m_dist[cell] = dist[v];
+            m_next[cell] = parent[v];
+        }
+    };
+
+    // Workers pull source nodes from a shared counter; each writes only its own columns
+    std::atomic<int> nextSource{ 0 };
+    auto worker = [&]() {
+        std::vector<float> dist(N);
+        std::vector<int> parent(N);
+        for (int s = nextSource++; s < N; s = nextSource++) dijkstraColumn(s, dist, parent);
+    };
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const int workers = (N < kParallelMinNodes) ? 1 : static_cast<int>(std::min<unsigned>(hw, static_cast<unsigned>(N)));
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int i = 1; i < workers; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    return true;
+}
+
+bool AllPairsTable::AppendPath(int from, const int to, std::vector<int>& out) const
+{
+    if (Distance(from, to) == kUnreachable) return false;
+
+    out.push_back(from);
+    while (from != to) {
+        from = NextHop(from, to);
+        out.push_back(from);
+    }
+    return true;
+}
+
+} // namespace Pathfinding
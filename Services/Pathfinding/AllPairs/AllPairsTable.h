@@ -0,0 +1,43 @@
+#pragma once
+
+/// @brief Precomputed all-pairs shortest-path distances and next hops for small, static nav graphs.
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+namespace Pathfinding {
+
+class Graph;
+
+// Dense N x N tables, row = 'from', column = 'to'. Built once at Rebuild by running one
+// Dijkstra per node across worker threads; afterwards a path is a table walk, no search.
+class AllPairsTable {
+public:
+  // Bytes needed for a graph of nodeCount nodes (distance + next-hop tables)
+  [[nodiscard]] static std::size_t BytesFor(int nodeCount);
+
+  // Builds the tables. Returns false and stays empty if they would exceed budgetBytes.
+  bool Build(const Graph& g, std::size_t budgetBytes);
+  void clear();
+
+  [[nodiscard]] bool empty() const { return m_n == 0; }
+
+  // Shortest distance between two nodes (infinity if unreachable)
+  [[nodiscard]] float Distance(const int from, const int to) const { return m_dist[static_cast<std::size_t>(from) * m_n + to]; }
+
+  // First node after 'from' on the shortest path to 'to' (-1 if unreachable or from == to)
+  [[nodiscard]] int NextHop(const int from, const int to) const { return m_next[static_cast<std::size_t>(from) * m_n + to]; }
+
+  // Appends the node sequence from -> to (both inclusive). Returns false if unreachable.
+  bool AppendPath(int from, int to, std::vector<int>& out) const;
+
+  static constexpr float kUnreachable = std::numeric_limits<float>::infinity();
+
+private:
+  int m_n{ 0 };
+  std::vector<float> m_dist{};
+  std::vector<int> m_next{};
+};
+
+} // namespace Pathfinding
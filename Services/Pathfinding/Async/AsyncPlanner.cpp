@@ -0,0 +1,99 @@
+#include "AsyncPlanner.h"
+
+namespace Pathfinding {
+
+AsyncPlanner::AsyncPlanner(const PathfinderService& pf)
+    : m_pf(pf), m_thread([this] { WorkerLoop(); })
+{
+}
+
+AsyncPlanner::~AsyncPlanner()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+AsyncPlanner::Ticket AsyncPlanner::Submit(const std::uint32_t owner, const PathQuery& query)
+{
+    Ticket ticket;
+    {
+        std::lock_guard lock(m_mutex);
+        ticket = ++m_nextTicket;
+        m_latest[owner] = ticket;
+        m_queue.push_back({ owner, ticket, query });
+    }
+    m_wake.notify_one();
+    return ticket;
+}
+
+void AsyncPlanner::Cancel(const std::uint32_t owner)
+{
+    std::lock_guard lock(m_mutex);
+    m_latest.erase(owner); // queued and in-flight requests of this owner are now stale
+}
+
+void AsyncPlanner::CancelAll()
+{
+    std::unique_lock lock(m_mutex);
+    m_latest.clear();
+    m_queue.clear();
+    m_completed.clear();
+    m_idle.wait(lock, [this] { return !m_busy; });
+    m_completed.clear(); // whatever the in-flight request produced
+}
+
+size_t AsyncPlanner::Drain(std::vector<Completed>& out, const size_t maxResults)
+{
+    std::lock_guard lock(m_mutex);
+    size_t appended = 0;
+    while (appended < maxResults && !m_completed.empty()) {
+        Completed& c = m_completed.front();
+        if (IsCurrent(c.owner, c.ticket)) {
+            m_latest.erase(c.owner);
+            out.push_back(std::move(c));
+            ++appended;
+        }
+        m_completed.pop_front();
+    }
+    return appended;
+}
+
+bool AsyncPlanner::IsCurrent(const std::uint32_t owner, const Ticket ticket) const
+{
+    const auto it = m_latest.find(owner);
+    return it != m_latest.end() && it->second == ticket;
+}
+
+void AsyncPlanner::WorkerLoop()
+{
+    for (;;) {
+        Request req;
+        {
+            std::unique_lock lock(m_mutex);
+            m_busy = false;
+            m_idle.notify_all();
+            m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+
+            req = m_queue.front();
+            m_queue.pop_front();
+            if (!IsCurrent(req.owner, req.ticket)) continue; // superseded before we got to it
+            m_busy = true;
+        }
+
+        Completed done{ req.owner, req.ticket, {} };
+        {
+            const auto planning = m_pf.LockForPlanning(); // graph changes wait for this request
+            if (auto result = m_pf.PlanPath(req.query.start, req.query.goal, m_ctx)) done.result = std::move(*result);
+        }
+
+        std::lock_guard lock(m_mutex);
+        if (IsCurrent(done.owner, done.ticket)) m_completed.push_back(std::move(done));
+    }
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,76 @@
+#pragma once
+
+/// @brief Background path planning queue: requests are planned off the game thread and collected later.
+
+#include "Pathfinding/PathfinderService.h"
+#include "Pathfinding/AStar/SearchContext.h"
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace Pathfinding {
+
+// One worker thread plans queued requests with its own search context. Every request belongs to
+// an owner (e.g. a tank id); a newer request from the same owner supersedes the older one, which
+// is then skipped if still queued or dropped when its result lands.
+// Each request is planned under PathfinderService::LockForPlanning, so graph changes wait for it; results
+// planned before a change still land (call CancelAll first to drop them).
+class AsyncPlanner {
+public:
+  using Ticket = std::uint64_t; // 0 is never issued
+
+  struct Completed {
+    std::uint32_t owner{ 0 };
+    Ticket ticket{ 0 };
+    PathResult result{};       // empty polyline when no path was found
+  };
+
+  explicit AsyncPlanner(const PathfinderService& pf);
+  ~AsyncPlanner();
+
+  // Queues a request and returns its ticket; supersedes the owner's previous request
+  Ticket Submit(std::uint32_t owner, const PathQuery& query);
+
+  // Drops the owner's outstanding request, if any
+  void Cancel(std::uint32_t owner);
+
+  // Drops every outstanding request and waits for the one being planned to finish
+  void CancelAll();
+
+  // Moves up to maxResults current (non-superseded) results into out, oldest first.
+  // Results beyond the budget stay queued for the next call. Returns the number appended.
+  size_t Drain(std::vector<Completed>& out, size_t maxResults);
+
+  AsyncPlanner(const AsyncPlanner&) = delete;
+  AsyncPlanner& operator=(const AsyncPlanner&) = delete;
+
+private:
+  struct Request {
+    std::uint32_t owner{ 0 };
+    Ticket ticket{ 0 };
+    PathQuery query{};
+  };
+
+  void WorkerLoop();
+  [[nodiscard]] bool IsCurrent(std::uint32_t owner, Ticket ticket) const; // requires m_mutex
+
+  const PathfinderService& m_pf;
+  SearchContext m_ctx{}; // only touched by the worker thread
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  std::deque<Request> m_queue{};
+  std::deque<Completed> m_completed{};
+  std::unordered_map<std::uint32_t, Ticket> m_latest{}; // owner -> newest outstanding ticket
+  Ticket m_nextTicket{ 0 };
+  bool m_busy{ false };
+  bool m_stop{ false };
+
+  std::thread m_thread; // started last, after every member it uses
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,281 @@
+#include "NavGraphFile.h"
+#include "Pathfinding/Graph/Graph.h"
+#include "Pathfinding/Graph/SpatialIndex.h"
+#include "Pathfinding/Environment/Environment.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Pathfinding {
+
+namespace {
+
+constexpr char kMagic[4] = { 'T', 'N', 'A', 'V' };
+constexpr std::uint32_t kEndianTag = 0x01020304u;
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint32_t headerSize;
+    std::uint64_t key;
+    std::uint64_t fileSize;
+    std::uint64_t checksum;      // of the payload after the header
+    // Graph
+    std::int32_t nodes;
+    std::int32_t edges;          // directed
+    // Spatial index
+    std::int32_t cols;
+    std::int32_t rows;
+    std::int32_t edgeItems;
+    std::int32_t indexEdges;     // unique undirected edges
+    float cellSize;
+    float originX;
+    float originY;
+    std::int32_t padding;
+};
+static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 80);
+
+std::uint64_t PayloadBytes(const FileHeader& h)
+{
+    const std::uint64_t n = h.nodes, e = h.edges, cells = static_cast<std::uint64_t>(h.cols) * h.rows;
+    const std::uint64_t words = (n + 1) + 2 * e + 3 * n // graph + components
+                              + (cells + 1) + n + (cells + 1) + h.edgeItems + 2ull * h.indexEdges; // index
+    return words * 4;
+}
+
+// FNV-1a over 32-bit words (the payload is all 4-byte elements)
+std::uint64_t Checksum(const std::byte* data, const size_t bytes)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i + 4 <= bytes; i += 4) {
+        std::uint32_t w;
+        std::memcpy(&w, data + i, sizeof(w));
+        h ^= w;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Read-only view of a whole file; unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart <= 0) return;
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) return;
+        m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data) m_size = static_cast<size_t>(size.QuadPart);
+#else
+        m_fd = open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) return;
+        struct stat st{};
+        if (fstat(m_fd, &st) != 0 || st.st_size <= 0) return;
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (p == MAP_FAILED) return;
+        m_data = static_cast<const std::byte*>(p);
+        m_size = static_cast<size_t>(st.st_size);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+        if (m_data) munmap(const_cast<std::byte*>(m_data), m_size);
+        if (m_fd >= 0) close(m_fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] const std::byte* data() const { return m_data; }
+    [[nodiscard]] size_t size() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    HANDLE m_file{ INVALID_HANDLE_VALUE };
+    HANDLE m_mapping{ nullptr };
+#else
+    int m_fd{ -1 };
+#endif
+    const std::byte* m_data{ nullptr };
+    size_t m_size{ 0 };
+};
+
+// Sequential reader over the mapped payload (sizes were checked against the header up front)
+struct Cursor {
+    const std::byte* at;
+
+    template <typename T>
+    void take(std::vector<T>& out, const size_t count) {
+        out.resize(count);
+        std::memcpy(out.data(), at, count * sizeof(T));
+        at += count * sizeof(T);
+    }
+};
+
+// CSR-style start array: starts at 0, never decreases, ends at 'total'
+bool ValidStarts(const std::vector<int>& starts, const int total)
+{
+    return !starts.empty() && starts.front() == 0 && starts.back() == total && std::ranges::is_sorted(starts);
+}
+
+bool AllInRange(const std::vector<int>& v, const int end)
+{
+    return std::ranges::all_of(v, [end](const int i) { return i >= 0 && i < end; });
+}
+
+} // namespace
+
+std::uint64_t NavGraphFile::Key(const Rect& outer, const std::vector<Rect>& obstacles, const float indexCellSize)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](const std::uint32_t word) {
+        for (int i = 0; i < 4; ++i) {
+            h ^= (word >> (8 * i)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+    };
+    auto mixFloat = [&mix](const float f) { std::uint32_t w; std::memcpy(&w, &f, sizeof(w)); mix(w); };
+    auto mixRect = [&mixFloat](const Rect& r) { mixFloat(r.minx); mixFloat(r.miny); mixFloat(r.maxx); mixFloat(r.maxy); };
+
+    mix(kVersion);
+    mixFloat(indexCellSize);
+    mixRect(outer);
+    mix(static_cast<std::uint32_t>(obstacles.size()));
+    for (const Rect& r : obstacles) mixRect(r);
+    return h;
+}
+
+bool NavGraphFile::Save(const std::string& path, const std::uint64_t key, const Graph& g, const std::vector<int>& components, const SpatialIndex& index)
+{
+    if (g.size() == 0 || static_cast<int>(components.size()) != g.size()) return false;
+
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.endianTag = kEndianTag;
+    h.headerSize = sizeof(FileHeader);
+    h.key = key;
+    h.nodes = g.size();
+    h.edges = g.edgeCount();
+    h.cols = index.m_cols;
+    h.rows = index.m_rows;
+    h.edgeItems = static_cast<std::int32_t>(index.m_edgeItems.size());
+    h.indexEdges = static_cast<std::int32_t>(index.m_edges.size());
+    h.cellSize = index.m_cellSize;
+    h.originX = index.m_originX;
+    h.originY = index.m_originY;
+    h.fileSize = sizeof(FileHeader) + PayloadBytes(h);
+
+    // Payload assembled in memory first so the checksum can go in the header
+    std::vector<std::byte> payload;
+    payload.reserve(PayloadBytes(h));
+    auto put = [&payload](const auto& v) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(v.data());
+        payload.insert(payload.end(), bytes, bytes + v.size() * sizeof(v[0]));
+    };
+    put(g.m_offsets); put(g.m_targets); put(g.m_costs); put(g.m_x); put(g.m_y);
+    put(components);
+    put(index.m_nodeCellStart); put(index.m_nodeItems);
+    put(index.m_edgeCellStart); put(index.m_edgeItems);
+    for (const auto& [a, b] : index.m_edges) put(std::array<std::int32_t, 2>{ a, b });
+    h.checksum = Checksum(payload.data(), payload.size());
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!out.flush()) return false;
+    }
+
+    // Readers only ever see a complete file
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (!ec) return true;
+    std::filesystem::remove(tmp, ec);
+    return false;
+}
+
+bool NavGraphFile::Load(const std::string& path, const std::uint64_t key, Graph& outGraph, std::vector<int>& outComponents, SpatialIndex& outIndex)
+{
+    const MappedFile file(path);
+    if (!file.data() || file.size() < sizeof(FileHeader)) return false;
+
+    // 1. Header: right format, right inputs, sizes consistent with the file
+    FileHeader h{};
+    std::memcpy(&h, file.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion || h.endianTag != kEndianTag ||
+        h.headerSize != sizeof(FileHeader) || h.key != key) return false;
+    if (h.nodes <= 0 || h.edges < 0 || h.cols <= 0 || h.rows <= 0 || h.edgeItems < 0 || h.indexEdges < 0) return false;
+    if (h.fileSize != file.size() || h.fileSize != sizeof(FileHeader) + PayloadBytes(h)) return false;
+    if (Checksum(file.data() + sizeof(FileHeader), file.size() - sizeof(FileHeader)) != h.checksum) return false;
+
+    // 2. Arrays into scratch copies, so a corrupt file leaves the outputs alone
+    Graph g;
+    SpatialIndex index;
+    std::vector<int> components;
+    const int n = h.nodes, cells = h.cols * h.rows;
+
+    Cursor in{ file.data() + sizeof(FileHeader) };
+    in.take(g.m_offsets, n + 1); in.take(g.m_targets, h.edges); in.take(g.m_costs, h.edges);
+    in.take(g.m_x, n); in.take(g.m_y, n);
+    in.take(components, n);
+    in.take(index.m_nodeCellStart, cells + 1); in.take(index.m_nodeItems, n);
+    in.take(index.m_edgeCellStart, cells + 1); in.take(index.m_edgeItems, h.edgeItems);
+    std::vector<int> indexEdges;
+    in.take(indexEdges, 2 * static_cast<size_t>(h.indexEdges));
+
+    // 3. Structure: every offset and id must stay in bounds for the queries that index with them
+    if (!ValidStarts(g.m_offsets, h.edges) || !AllInRange(g.m_targets, n) || !AllInRange(components, n)) return false;
+    if (!ValidStarts(index.m_nodeCellStart, n) || !AllInRange(index.m_nodeItems, n)) return false;
+    if (!ValidStarts(index.m_edgeCellStart, h.edgeItems) || !AllInRange(index.m_edgeItems, h.indexEdges)) return false;
+    index.m_edges.resize(h.indexEdges);
+    for (int i = 0; i < h.indexEdges; ++i) {
+        const int a = indexEdges[2 * i], b = indexEdges[2 * i + 1];
+        if (a < 0 || a >= b || b >= n) return false;
+        index.m_edges[i] = { a, b };
+    }
+    if (!(h.cellSize >= 1.0f)) return false;
+
+    index.m_cols = h.cols;
+    index.m_rows = h.rows;
+    index.m_cellSize = h.cellSize;
+    index.m_originX = h.originX;
+    index.m_originY = h.originY;
+
+    outGraph = std::move(g);
+    outComponents = std::move(components);
+    outIndex = std::move(index);
+    return true;
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,37 @@
+#pragma once
+
+/// @brief Versioned binary file of a built nav graph (CSR arrays, positions, component labels, spatial index) for fast startup.
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace Pathfinding {
+
+class Graph;
+class SpatialIndex;
+struct Rect;
+
+// Layout (native endianness, checked on load), every array 4-byte elements:
+//   header | offsets[n+1] targets[e] costs[e] x[n] y[n] components[n]
+//          | nodeCellStart[c+1] nodeItems[n] edgeCellStart[c+1] edgeItems[k] indexEdges[2*u]
+// The header carries a key hashed from everything the graph is built from and a payload checksum,
+// so a file written for another map or config, or damaged, is rejected (the caller rebuilds and
+// overwrites it).
+class NavGraphFile {
+public:
+  // Bump whenever the layout or the builder output changes
+  static constexpr std::uint32_t kVersion = 1;
+
+  // FNV-1a over the build inputs: outer rect, inflated obstacles, index cell size and kVersion
+  static std::uint64_t Key(const Rect& outer, const std::vector<Rect>& obstacles, float indexCellSize);
+
+  // Writes to a temp file and renames it over 'path'. False on I/O errors or an empty graph.
+  static bool Save(const std::string& path, std::uint64_t key, const Graph& g, const std::vector<int>& components, const SpatialIndex& index);
+
+  // Memory-maps 'path' and fills the outputs if the file is intact and was written for 'key'.
+  // Returns false (outputs untouched) if it is missing, stale or corrupt.
+  static bool Load(const std::string& path, std::uint64_t key, Graph& outGraph, std::vector<int>& outComponents, SpatialIndex& outIndex);
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,86 @@
+#include "PathCache.h"
+
+namespace Pathfinding {
+
+size_t PathCache::KeyHash::operator()(const PathCacheKey& k) const
+{
+    // FNV-1a over the eight ints of the key
+    const int fields[] = { k.start.node, k.start.a, k.start.b, k.start.bucket,
+                           k.goal.node,  k.goal.a,  k.goal.b,  k.goal.bucket };
+    std::uint64_t h = 14695981039346656037ull;
+    for (const int f : fields) {
+        h ^= static_cast<std::uint32_t>(f);
+        h *= 1099511628211ull;
+    }
+    return static_cast<size_t>(h);
+}
+
+void PathCache::SetCapacity(const size_t capacity)
+{
+    std::lock_guard lock(m_mutex);
+    m_capacity = capacity;
+    while (m_lru.size() > m_capacity) {
+        m_map.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+}
+
+bool PathCache::Lookup(const PathCacheKey& key, std::vector<Play::Vector2D>& outPolyline, float& outCost)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_capacity == 0) return false;
+
+    const auto it = m_map.find(key);
+    if (it == m_map.end()) {
+        ++m_stats.misses;
+        return false;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    outPolyline = it->second->polyline;
+    outCost = it->second->cost;
+    ++m_stats.hits;
+    return true;
+}
+
+void PathCache::Insert(const PathCacheKey& key, const std::vector<Play::Vector2D>& polyline, const float cost)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_capacity == 0) return;
+
+    if (const auto it = m_map.find(key); it != m_map.end()) {
+        // Another thread planned the same query concurrently; keep the newer result
+        it->second->polyline = polyline;
+        it->second->cost = cost;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+
+    if (m_lru.size() >= m_capacity) {
+        m_map.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+    m_lru.push_front(Entry{ key, polyline, cost });
+    m_map.emplace(key, m_lru.begin());
+}
+
+void PathCache::Clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_lru.clear();
+    m_map.clear();
+}
+
+PathCache::Stats PathCache::GetStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void PathCache::ResetStats()
+{
+    std::lock_guard lock(m_mutex);
+    m_stats = {};
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,72 @@
+#pragma once
+
+/// @brief Small LRU cache of planned paths keyed by quantized graph attachment points.
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <Play.h>
+
+namespace Pathfinding {
+
+// One path endpoint as seen by the graph: a node, or a bucket along an undirected edge (a < b).
+// Points that attach to the same node/bucket share cache entries.
+struct PathCacheEndpoint {
+  int node{ -1 };
+  int a{ -1 };
+  int b{ -1 };
+  int bucket{ 0 };
+
+  bool operator==(const PathCacheEndpoint&) const = default;
+};
+
+struct PathCacheKey {
+  PathCacheEndpoint start{};
+  PathCacheEndpoint goal{};
+
+  bool operator==(const PathCacheKey&) const = default;
+};
+
+// Thread-safe LRU map from key to (polyline, cost). Owned by PathfinderService, which clears it
+// whenever the graph or config changes. A capacity of 0 disables caching.
+class PathCache {
+public:
+  struct Stats {
+    std::uint64_t hits{ 0 };
+    std::uint64_t misses{ 0 };
+  };
+
+  void SetCapacity(size_t capacity);
+
+  // Copies the cached entry into the out params and marks it most recently used
+  bool Lookup(const PathCacheKey& key, std::vector<Play::Vector2D>& outPolyline, float& outCost);
+  void Insert(const PathCacheKey& key, const std::vector<Play::Vector2D>& polyline, float cost);
+
+  // Drops all entries (counters are kept)
+  void Clear();
+
+  [[nodiscard]] Stats GetStats() const;
+  void ResetStats();
+
+private:
+  struct KeyHash {
+    size_t operator()(const PathCacheKey& k) const;
+  };
+
+  struct Entry {
+    PathCacheKey key{};
+    std::vector<Play::Vector2D> polyline{};
+    float cost{ 0.0f };
+  };
+
+  mutable std::mutex m_mutex;
+  size_t m_capacity{ 0 };
+  std::list<Entry> m_lru{}; // front = most recently used
+  std::unordered_map<PathCacheKey, std::list<Entry>::iterator, KeyHash> m_map{};
+  Stats m_stats{};
+};
+
+} // namespace Pathfinding
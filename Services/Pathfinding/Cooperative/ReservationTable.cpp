@@ -0,0 +1,63 @@
+#include "ReservationTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Pathfinding {
+
+void ReservationTable::Configure(const float stepSec)
+{
+    m_stepSec = std::max(1e-3f, stepSec);
+    Clear();
+}
+
+void ReservationTable::Clear()
+{
+    m_clock = 0.0f;
+    m_now = 0;
+    m_nodes.clear();
+    m_edges.clear();
+    m_held.clear();
+}
+
+void ReservationTable::Advance(const float dt)
+{
+    m_clock += dt;
+    const auto now = static_cast<std::uint32_t>(std::floor(m_clock / m_stepSec));
+    if (now == m_now) return;
+    m_now = now;
+
+    // Steps before the current one can no longer conflict with anything
+    auto expire = [this](Slots& slots, std::vector<std::uint64_t>& keys) {
+        std::erase_if(keys, [&](const std::uint64_t key) {
+            if (StepOf(key) >= m_now) return false;
+            slots.erase(key);
+            return true;
+        });
+    };
+    for (auto it = m_held.begin(); it != m_held.end();) {
+        expire(m_nodes, it->second.nodes);
+        expire(m_edges, it->second.edges);
+        it = (it->second.nodes.empty() && it->second.edges.empty()) ? m_held.erase(it) : std::next(it);
+    }
+}
+
+void ReservationTable::ReserveNode(const int node, const std::uint32_t step, const int agent)
+{
+    if (m_nodes.try_emplace(Key(node, step), agent).second) m_held[agent].nodes.push_back(Key(node, step));
+}
+
+void ReservationTable::ReserveEdge(const int edge, const std::uint32_t step, const int agent)
+{
+    if (m_edges.try_emplace(Key(edge, step), agent).second) m_held[agent].edges.push_back(Key(edge, step));
+}
+
+void ReservationTable::Release(const int agent)
+{
+    const auto it = m_held.find(agent);
+    if (it == m_held.end()) return;
+    for (const std::uint64_t key : it->second.nodes) m_nodes.erase(key);
+    for (const std::uint64_t key : it->second.edges) m_edges.erase(key);
+    m_held.erase(it);
+}
+
+} // namespace Pathfinding
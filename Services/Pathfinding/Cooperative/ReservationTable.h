@@ -0,0 +1,64 @@
+#pragma once
+
+/// @brief Space-time reservations of graph nodes and edges for cooperative (WHCA*) planning.
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Pathfinding {
+
+// Time is cut into fixed steps counted from the first Advance. An agent's plan reserves the nodes it
+// stands on and the directed edges it drives along, per step; later plans of other agents treat
+// those as taken. Reservations in the past are dropped as the clock advances, and an agent's
+// reservations are replaced whenever it plans again. Main thread only.
+class ReservationTable {
+public:
+  void Configure(float stepSec);
+  void Clear();
+
+  [[nodiscard]] float StepSec() const { return m_stepSec; }
+  [[nodiscard]] std::uint32_t Now() const { return m_now; }
+  // Seconds already gone of the current step
+  [[nodiscard]] float Phase() const { return m_clock - static_cast<float>(m_now) * m_stepSec; }
+
+  // Moves the clock and forgets reservations that ended
+  void Advance(float dt);
+
+  [[nodiscard]] bool NodeFree(int node, std::uint32_t step, int agent) const { return Free(m_nodes, node, step, agent); }
+  [[nodiscard]] bool EdgeFree(int edge, std::uint32_t step, int agent) const { return Free(m_edges, edge, step, agent); }
+
+  void ReserveNode(int node, std::uint32_t step, int agent);
+  void ReserveEdge(int edge, std::uint32_t step, int agent);
+
+  // Drops everything the agent holds
+  void Release(int agent);
+
+  [[nodiscard]] size_t size() const { return m_nodes.size() + m_edges.size(); }
+
+private:
+  using Slots = std::unordered_map<std::uint64_t, int>; // (id, step) -> agent
+
+  static std::uint64_t Key(const int id, const std::uint32_t step) { return (static_cast<std::uint64_t>(id) << 32) | step; }
+  static std::uint32_t StepOf(const std::uint64_t key) { return static_cast<std::uint32_t>(key); }
+
+  [[nodiscard]] static bool Free(const Slots& slots, const int id, const std::uint32_t step, const int agent) {
+    const auto it = slots.find(Key(id, step));
+    return it == slots.end() || it->second == agent;
+  }
+
+  struct Held {
+    std::vector<std::uint64_t> nodes{};
+    std::vector<std::uint64_t> edges{};
+  };
+
+  float m_stepSec{ 0.25f };
+  float m_clock{ 0.0f };
+  std::uint32_t m_now{ 0 };
+  Slots m_nodes{};
+  Slots m_edges{};
+  std::unordered_map<int, Held> m_held{}; // per agent, to release/expire without scanning the slots
+};
+
+} // namespace Pathfinding
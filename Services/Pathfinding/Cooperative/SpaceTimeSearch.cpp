@@ -0,0 +1,160 @@
+#include "SpaceTimeSearch.h"
+#include "Pathfinding/FlowField/FlowField.h"
+#include "Pathfinding/AStar/SearchPolicies.h"
+#include "Helper/Geometry.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+
+namespace Pathfinding {
+
+namespace {
+
+// Steps a node stays reserved before its agent arrives and after it left (a tank length or so at
+// cruise speed, so agents passing one node keep apart)
+constexpr std::uint32_t kClearanceSteps = 2;
+
+// Searches give up beyond this many expanded states (the caller falls back to a plain path)
+constexpr int kMaxExpansions = 4096;
+
+struct State {
+  int node;
+  std::uint32_t step;
+  float g;
+  int parent;
+  bool holding; // still where the agent started: it may always stay there (it cannot vanish)
+};
+
+// Nobody else around the node from 'first' to 'last' step
+bool NodeFreeBetween(const ReservationTable& table, const int node, const std::uint32_t first, const std::uint32_t last, const int agent)
+{
+  for (std::uint32_t s = first; s <= last; ++s)
+    if (!table.NodeFree(node, s, agent)) return false;
+  return true;
+}
+
+std::uint64_t StateKey(const int node, const std::uint32_t step) { return (static_cast<std::uint64_t>(node) << 32) | step; }
+
+int TravelSteps(const float length, const float stepPx)
+{
+  return std::max(1, static_cast<int>(std::ceil(length / stepPx)));
+}
+
+} // namespace
+
+bool FindSpaceTimePath(const Graph& g, const ReservationTable& table, const FlowField& field,
+                       const std::span<const NodeTerminal> starts, const SpaceTimeQuery& query, std::vector<SpaceTimeStep>& outPath)
+{
+  outPath.clear();
+  const int agent = query.agent;
+  const std::uint32_t windowEnd = query.startStep + static_cast<std::uint32_t>(std::max(1, query.windowSteps));
+
+  std::vector<State> states;
+  std::unordered_map<std::uint64_t, int> best; // (node, step) -> state index
+  BinaryHeapOpenList open;
+
+  auto push = [&](const int node, const std::uint32_t step, const float cost, const int parent, const bool holding) {
+    const auto [it, inserted] = best.try_emplace(StateKey(node, step), static_cast<int>(states.size()));
+    if (!inserted) {
+      State& s = states[it->second];
+      if (cost >= s.g) return;
+      s.g = cost;
+      s.parent = parent;
+      s.holding = holding;
+      open.push(it->second, cost + field.Distance(node));
+      return;
+    }
+    states.push_back({ node, step, cost, parent, holding });
+    open.push(it->second, cost + field.Distance(node));
+  };
+
+  // The agent is not on the graph yet: reaching an exit takes the stretch to it, unchecked
+  for (const NodeTerminal& s : starts) {
+    if (s.cost == kBlockedCost || field.Distance(s.node) == kBlockedCost) continue;
+    const int k = s.cost > 0.0f ? TravelSteps(s.cost, query.stepPx) : 0;
+    push(s.node, query.startStep + k, static_cast<float>(k) * query.stepPx, -1, true);
+  }
+
+  std::vector<char> closed;
+  int goalState = -1, expanded = 0;
+  while (!open.empty() && expanded < kMaxExpansions) {
+    const int si = open.pop().node;
+    if (static_cast<size_t>(si) >= closed.size()) closed.resize(states.size(), 0);
+    if (closed[si]) continue;
+    closed[si] = 1;
+    ++expanded;
+
+    const State cur = states[si];
+    // Past the window the field takes over; a goal exit ends the plan (the agent parks there)
+    if (cur.step >= windowEnd || field.NextHop(cur.node) < 0) { goalState = si; break; }
+
+    // Wait one step in place
+    if (cur.holding || table.NodeFree(cur.node, cur.step + 1, agent))
+      push(cur.node, cur.step + 1, cur.g + query.stepPx, si, cur.holding);
+
+    // Drive to a neighbour: its node must be free on arrival, nobody may come the other way
+    // meanwhile, and the node left behind keeps its clearance
+    if (!NodeFreeBetween(table, cur.node, cur.step + 1, cur.step + kClearanceSteps, agent)) continue;
+    for (int e = g.edgeBegin(cur.node); e < g.edgeEnd(cur.node); ++e) {
+      if (g.edgeCost(e) == kBlockedCost) continue;
+      const int v = g.edgeTarget(e);
+      if (field.Distance(v) == kBlockedCost) continue;
+      const int k = TravelSteps(g.edgeCost(e), query.stepPx);
+      const std::uint32_t arrive = cur.step + static_cast<std::uint32_t>(k);
+      if (!NodeFreeBetween(table, v, arrive - std::min<std::uint32_t>(arrive, kClearanceSteps), arrive, agent)) continue;
+
+      const int back = g.findEdge(v, cur.node);
+      bool headOn = false;
+      for (std::uint32_t s = cur.step; s < arrive && s < windowEnd && !headOn; ++s)
+        headOn = !table.EdgeFree(back, s, agent);
+      if (headOn) continue;
+
+      push(v, arrive, cur.g + static_cast<float>(k) * query.stepPx, si, false);
+    }
+  }
+  if (goalState < 0) return false;
+
+  // Chain of states back to the start; runs of one node are waits
+  std::vector<int> chain;
+  for (int s = goalState; s >= 0; s = states[s].parent) chain.push_back(s);
+  std::ranges::reverse(chain);
+  for (const int s : chain) {
+    const State& st = states[s];
+    if (!outPath.empty() && outPath.back().node == st.node) { outPath.back().depart = st.step; continue; }
+    outPath.push_back({ st.node, st.step, st.step });
+  }
+  return true;
+}
+
+void ReserveSpaceTimePath(const Graph& g, ReservationTable& table, const std::span<const SpaceTimeStep> path,
+                          const SpaceTimeQuery& query, const bool parked)
+{
+  const int agent = query.agent;
+  const std::uint32_t windowEnd = query.startStep + static_cast<std::uint32_t>(std::max(1, query.windowSteps));
+
+  table.Release(agent);
+  for (size_t i = 0; i < path.size(); ++i) {
+    const SpaceTimeStep& p = path[i];
+    const bool last = i + 1 == path.size();
+    const std::uint32_t enter = p.arrive - std::min<std::uint32_t>(p.arrive, kClearanceSteps);
+    const std::uint32_t leave = (last && parked) ? windowEnd : p.depart + kClearanceSteps;
+    for (std::uint32_t s = enter; s <= leave && s <= windowEnd; ++s) table.ReserveNode(p.node, s, agent);
+    if (last) break;
+
+    const int e = g.findEdge(p.node, path[i + 1].node);
+    for (std::uint32_t s = p.depart; s < path[i + 1].arrive && s < windowEnd; ++s) table.ReserveEdge(e, s, agent);
+  }
+}
+
+void ReserveEdgeStretch(const Graph& g, ReservationTable& table, const int a, const int b, const std::uint32_t first,
+                        const std::uint32_t last, const int agent)
+{
+  // Movers only check the direction against them, so both directions are taken
+  const int ab = g.findEdge(a, b), ba = g.findEdge(b, a);
+  for (std::uint32_t s = first; s <= last; ++s) {
+    table.ReserveEdge(ab, s, agent);
+    table.ReserveEdge(ba, s, agent);
+  }
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,47 @@
+#pragma once
+
+/// @brief Windowed cooperative A* (WHCA*): space-time search around other agents' reservations.
+
+#include "ReservationTable.h"
+#include "Pathfinding/Graph/Graph.h"
+#include <vector>
+#include <span>
+#include <cstdint>
+
+namespace Pathfinding {
+
+class FlowField;
+
+// One node of a cooperative plan: reached at step 'arrive', left at step 'depart' (later than
+// 'arrive' when the agent has to wait there for someone to pass)
+struct SpaceTimeStep {
+  int node{ -1 };
+  std::uint32_t arrive{ 0 };
+  std::uint32_t depart{ 0 };
+};
+
+struct SpaceTimeQuery {
+  int agent{ -1 };
+  std::uint32_t startStep{ 0 };
+  int windowSteps{ 16 };   // steps planned around reservations; the rest follows the field
+  float stepPx{ 30.0f };   // distance driven per step
+};
+
+// A* over (node, step) states from the start terminals, with wait and move actions, avoiding nodes
+// reserved by other agents and edges they drive the opposite way. The field to the goal is the
+// heuristic (exact distance ignoring other agents), so the search stops at the first state that is
+// past the window or parked at a goal exit. outPath[0] is the first node after the start.
+// False if no state could be reached (everything around the start is taken).
+bool FindSpaceTimePath(const Graph& g, const ReservationTable& table, const FlowField& field,
+                       std::span<const NodeTerminal> starts, const SpaceTimeQuery& query, std::vector<SpaceTimeStep>& outPath);
+
+// Reserves a plan from FindSpaceTimePath for query.agent (nodes with clearance steps around the visit,
+// edges while driving them; a parked agent keeps its node to the end of the window)
+void ReserveSpaceTimePath(const Graph& g, ReservationTable& table, std::span<const SpaceTimeStep> path,
+                          const SpaceTimeQuery& query, bool parked);
+
+// Closes edge (a, b) in both directions to other agents from step 'first' to 'last': the agent is
+// somewhere along it, off the nodes (driving onto the graph, or parked at a goal between nodes)
+void ReserveEdgeStretch(const Graph& g, ReservationTable& table, int a, int b, std::uint32_t first, std::uint32_t last, int agent);
+
+} // namespace Pathfinding
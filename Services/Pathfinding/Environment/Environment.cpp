@@ -53,6 +53,11 @@ std::vector<Rect> BuildInflatedObstacles(const PathfindingConfig& params)
 	return obstacles;
 }
 
+Rect InflateRect(const Rect& rect, const float by)
+{
+	return { rect.minx - by, rect.miny - by, rect.maxx + by, rect.maxy + by };
+}
+
 bool PointInRect(const Play::Vector2D& point, const Rect& rect)
 {
 	// Use inclusive bounds to allow points on rectangle edges
@@ -100,4 +105,29 @@ bool SegmentHitsAnyRect(const Play::Vector2D& a, const Play::Vector2D& b, const
 });
 }
 
+void ObstacleSet::Build(std::vector<Rect> rects, const float cellSize)
+{
+	m_rects = std::move(rects);
+	std::vector<Geom::Box> boxes;
+	boxes.reserve(m_rects.size());
+	for (const auto& [minx, miny, maxx, maxy] : m_rects) boxes.push_back({ minx, miny, maxx, maxy });
+	m_grid.Build(boxes, cellSize);
+}
+
+void ObstacleSet::clear()
+{
+	m_rects.clear();
+	m_grid.clear();
+}
+
+bool ObstacleSet::SegmentHitsAny(const Play::Vector2D& a, const Play::Vector2D& b) const
+{
+	return m_grid.AnyOnSegment(a, b, [&](const int i) { return SegmentIntersectsRect(a, b, m_rects[i]); });
+}
+
+bool ObstacleSet::ContainsPoint(const Play::Vector2D& point) const
+{
+	return m_grid.AnyAtPoint(point, [&](const int i) { return PointInRect(point, m_rects[i]); });
+}
+
 } // namespace Pathfinding
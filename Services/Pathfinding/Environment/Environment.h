@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <Play.h>
+#include "Helper/RectGrid.h"
 
 namespace Pathfinding {
 
@@ -24,6 +25,9 @@ Rect GetOuterPlayableRect(const PathfindingConfig& params);
 // True if point is strictly inside the inset outer rect (excludes boundary).
 bool PointInOuterPlayable(const Play::Vector2D& point, const PathfindingConfig& params);
 
+// Grow a rectangle by 'by' on every side
+Rect InflateRect(const Rect& rect, float by);
+
 // Build inflated obstacle rectangles from current map structures and Params.
 // Excludes the last structure (outer wall) by convention!
 std::vector<Rect> BuildInflatedObstacles(const PathfindingConfig& params);
@@ -36,4 +40,21 @@ bool PointInRect(const Play::Vector2D& point, const Rect& rect);
 bool SegmentIntersectsRect(const Play::Vector2D& a, const Play::Vector2D& b, const Rect& rect);
 bool SegmentHitsAnyRect(const Play::Vector2D& a, const Play::Vector2D& b, const std::vector<Rect>& rects);
 
+// Static obstacle rects with a uniform grid over them: the tests above, against the set, only look
+// at the rects in the cells a segment crosses (or a point lies in). Read-only after Build.
+class ObstacleSet {
+public:
+  void Build(std::vector<Rect> rects, float cellSize);
+  void clear();
+  [[nodiscard]] const std::vector<Rect>& Rects() const { return m_rects; }
+
+  // Same results as SegmentHitsAnyRect / PointInRect over Rects()
+  [[nodiscard]] bool SegmentHitsAny(const Play::Vector2D& a, const Play::Vector2D& b) const;
+  [[nodiscard]] bool ContainsPoint(const Play::Vector2D& point) const;
+
+private:
+  std::vector<Rect> m_rects{};
+  Geom::RectGrid m_grid{};
+};
+
 } // namespace Pathfinding
\ No newline at end of file
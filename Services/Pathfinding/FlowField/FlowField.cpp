@@ -0,0 +1,46 @@
+#include "FlowField.h"
+#include <algorithm>
+
+namespace Pathfinding {
+
+void FlowField::Build(const Graph& g, const std::span<const NodeTerminal> goals)
+{
+    const int n = g.size();
+    m_dist.assign(n, kBlockedCost);
+    m_next.assign(n, -1);
+    m_terminal.assign(n, -1);
+    m_goals.assign(goals.begin(), goals.end());
+
+    struct OpenRec { int node; float d; };
+    auto greater = [](const OpenRec& a, const OpenRec& b) { return a.d > b.d; };
+    std::vector<OpenRec> open;
+    open.reserve(static_cast<size_t>(n) / 4 + 8);
+
+    for (const auto& [node, cost] : goals) {
+        if (node < 0 || !(cost < m_dist[node])) continue;
+        m_dist[node] = cost;
+        m_terminal[node] = node;
+        open.push_back({ node, cost });
+        std::ranges::push_heap(open, greater);
+    }
+
+    while (!open.empty()) {
+        std::ranges::pop_heap(open, greater);
+        const auto [u, du] = open.back();
+        open.pop_back();
+        if (du > m_dist[u]) continue; // stale entry
+
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const int v = g.edgeTarget(e);
+            const float dv = du + g.edgeCost(e);
+            if (!(dv < m_dist[v])) continue;
+            m_dist[v] = dv;
+            m_next[v] = u;
+            m_terminal[v] = m_terminal[u];
+            open.push_back({ v, dv });
+            std::ranges::push_heap(open, greater);
+        }
+    }
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,40 @@
+#pragma once
+
+/// @brief Reverse Dijkstra field over the nav graph: distance to one goal and the next hop towards it from every node.
+
+#include "Pathfinding/Graph/Graph.h"
+#include <vector>
+#include <span>
+
+namespace Pathfinding {
+
+// Built once per goal and then read-only, so any number of agents (and threads) can walk it.
+// Edge costs are symmetric, so a search outwards from the goal's exit nodes gives every node its
+// shortest distance to the goal; NextHop is the neighbour that distance was reached through.
+class FlowField {
+public:
+  // 'goals' are the nodes the goal point is reached from, with the cost of the last stretch
+  void Build(const Graph& g, std::span<const NodeTerminal> goals);
+
+  [[nodiscard]] bool empty() const { return m_next.empty(); }
+
+  // Cost from the node to the goal point (kBlockedCost if it cannot reach it)
+  [[nodiscard]] float Distance(const int node) const { return m_dist[node]; }
+
+  // Next node towards the goal; -1 at the goal's exit nodes and at nodes that cannot reach it
+  [[nodiscard]] int NextHop(const int node) const { return m_next[node]; }
+
+  // Goal terminal the walk from 'node' ends at (the last node before the goal point); -1 if unreachable
+  [[nodiscard]] int Terminal(const int node) const { return m_terminal[node]; }
+
+  // The goals the field was built from
+  [[nodiscard]] std::span<const NodeTerminal> Goals() const { return m_goals; }
+
+private:
+  std::vector<NodeTerminal> m_goals{};
+  std::vector<float> m_dist{};
+  std::vector<int> m_next{};
+  std::vector<int> m_terminal{};
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,92 @@
+#include "FlowFieldCache.h"
+#include <algorithm>
+
+namespace Pathfinding {
+
+void FlowFieldCache::Configure(const size_t capacity, const float ttlSec, const int minStarts)
+{
+    std::lock_guard lock(m_mutex);
+    m_capacity = capacity;
+    m_ttlSec = ttlSec;
+    m_minStarts = std::max(1, minStarts);
+    m_entries.clear();
+}
+
+std::shared_ptr<const FlowField> FlowFieldCache::Request(const PathCacheEndpoint& goal, const PathCacheEndpoint& start, bool& outBuild)
+{
+    outBuild = false;
+    std::lock_guard lock(m_mutex);
+    if (m_capacity == 0 || m_ttlSec <= 0.0f) return nullptr;
+
+    const auto it = std::ranges::find_if(m_entries, [&](const Entry& e) { return e.goal == goal; });
+    if (it == m_entries.end()) {
+        // Demand entries are cheap, but keep them bounded too: make room by dropping the oldest
+        if (m_entries.size() >= 4 * m_capacity)
+            m_entries.erase(std::ranges::max_element(m_entries, {}, &Entry::ageSec));
+        m_entries.push_back({ goal, start, 1, 0.0f, nullptr });
+        outBuild = (m_minStarts <= 1) && FieldCount() < m_capacity;
+        return nullptr;
+    }
+
+    if (it->field) {
+        ++m_stats.hits;
+        return it->field;
+    }
+
+    // The same agent re-requesting its goal every frame does not count as sharing it
+    if (!(it->lastStart == start)) {
+        it->lastStart = start;
+        ++it->starts;
+    }
+    outBuild = (it->starts >= m_minStarts) && FieldCount() < m_capacity;
+    return nullptr;
+}
+
+void FlowFieldCache::Insert(const PathCacheEndpoint& goal, std::shared_ptr<const FlowField> field)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_capacity == 0) return;
+
+    auto it = std::ranges::find_if(m_entries, [&](const Entry& e) { return e.goal == goal; });
+    if (it == m_entries.end()) {
+        m_entries.push_back({ goal, {}, m_minStarts, 0.0f, nullptr });
+        it = m_entries.end() - 1;
+    }
+    if (it->field) return; // another thread built it meanwhile
+    it->field = std::move(field);
+    ++m_stats.built;
+
+    // Over capacity (explicit fetches do not wait for room): the oldest other field goes
+    if (FieldCount() > m_capacity) {
+        Entry* oldest = nullptr;
+        for (Entry& e : m_entries)
+            if (e.field && !(e.goal == goal) && (!oldest || e.ageSec > oldest->ageSec)) oldest = &e;
+        if (oldest) oldest->field.reset();
+    }
+}
+
+size_t FlowFieldCache::FieldCount() const
+{
+    return static_cast<size_t>(std::ranges::count_if(m_entries, [](const Entry& e) { return e.field != nullptr; }));
+}
+
+void FlowFieldCache::Decay(const float dt)
+{
+    std::lock_guard lock(m_mutex);
+    for (Entry& e : m_entries) e.ageSec += dt;
+    std::erase_if(m_entries, [this](const Entry& e) { return e.ageSec > m_ttlSec; });
+}
+
+void FlowFieldCache::Clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_entries.clear();
+}
+
+FlowFieldCache::Stats FlowFieldCache::GetStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,62 @@
+#pragma once
+
+/// @brief Short-lived flow fields shared by every query towards the same goal bucket.
+
+#include "FlowField.h"
+#include "Pathfinding/Cache/PathCache.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pathfinding {
+
+// Goals are keyed like path cache endpoints (a node, or a bucket along an edge). A goal earns a
+// field once requests from minStarts different start points arrive within ttlSec of each other
+// and fewer than 'capacity' fields are live; from then on queries towards it read the field instead
+// of searching. Every entry (with or without a field) expires ttlSec after it was created, and all
+// of them are dropped whenever the graph changes. Thread-safe; fields are handed out as shared pointers, so an expired one stays
+// valid for readers still holding it.
+class FlowFieldCache {
+public:
+  struct Stats {
+    std::uint64_t built{ 0 };
+    std::uint64_t hits{ 0 };
+  };
+
+  // ttlSec <= 0 or capacity 0 disables sharing
+  void Configure(size_t capacity, float ttlSec, int minStarts);
+  [[nodiscard]] bool enabled() const { return m_capacity > 0 && m_ttlSec > 0.0f; }
+
+  // Records a request towards 'goal' from 'start'. Returns the goal's field if it has one;
+  // otherwise outBuild tells whether the caller should build it now and Insert it.
+  std::shared_ptr<const FlowField> Request(const PathCacheEndpoint& goal, const PathCacheEndpoint& start, bool& outBuild);
+  void Insert(const PathCacheEndpoint& goal, std::shared_ptr<const FlowField> field);
+
+  // Ages entries by dt and drops expired ones
+  void Decay(float dt);
+  void Clear();
+
+  [[nodiscard]] Stats GetStats() const;
+
+private:
+  [[nodiscard]] size_t FieldCount() const; // callers hold m_mutex
+
+  struct Entry {
+    PathCacheEndpoint goal{};
+    PathCacheEndpoint lastStart{};
+    int starts{ 0 };      // distinct consecutive start points seen
+    float ageSec{ 0.0f };
+    std::shared_ptr<const FlowField> field{};
+  };
+
+  mutable std::mutex m_mutex;
+  size_t m_capacity{ 0 };
+  float m_ttlSec{ 0.0f };
+  int m_minStarts{ 2 };
+  std::vector<Entry> m_entries{}; // few entries: linear scans
+  Stats m_stats{};
+};
+
+} // namespace Pathfinding
@@ -3,6 +3,7 @@
 /// @brief A simple undirected graph structure for pathfinding centerlines.
 
 #include <vector>
+#include <limits>
 #include <Play.h>
 
 namespace Pathfinding {
@@ -17,7 +18,8 @@ struct Node {
   std::vector<Edge> edges{};
 };
 
-class Graph {
+// Mutable adjacency-list form, only used while building. Freeze into a Graph for queries.
+class MutableGraph {
 
 public:
   int addNode(const Play::Vector2D& p) {
@@ -48,5 +50,78 @@ private:
   std::vector<Node> m_nodes{};
 };
 
-} // namespace Pathfinding
+// Cost of an edge that cannot be traversed; searches never relax it.
+inline constexpr float kBlockedCost = std::numeric_limits<float>::infinity();
+
+// A graph node plus the cost between it and a point off the graph (a query's start or goal),
+// e.g. the two ends of the edge a point attaches to
+struct NodeTerminal {
+  int node{ -1 };
+  float cost{ 0.0f };
+};
+
+// Frozen compressed-sparse-row graph. Outgoing edges of node u are the contiguous range
+// [edgeBegin(u), edgeEnd(u)) into the target/cost arrays; positions are stored SoA.
+class Graph {
+
+public:
+  // Replaces the contents with a frozen copy of 'src'
+  void assign(const MutableGraph& src) {
+    clear();
+    const int n = src.size();
+    m_x.reserve(n);
+    m_y.reserve(n);
+    m_offsets.reserve(n + 1);
+
+    for (const auto& [pos, edges] : src.nodes()) {
+      m_x.push_back(pos.x);
+      m_y.push_back(pos.y);
+      for (const auto& [to, cost] : edges) {
+        m_targets.push_back(to);
+        m_costs.push_back(cost);
+      }
+      m_offsets.push_back(static_cast<int>(m_targets.size()));
+    }
+  }
+
+  [[nodiscard]] int size() const { return static_cast<int>(m_x.size()); }
+  [[nodiscard]] int edgeCount() const { return static_cast<int>(m_targets.size()); } // directed
 
+  [[nodiscard]] Play::Vector2D pos(const int n) const { return { m_x[n], m_y[n] }; }
+  [[nodiscard]] float x(const int n) const { return m_x[n]; }
+  [[nodiscard]] float y(const int n) const { return m_y[n]; }
+
+  [[nodiscard]] int edgeBegin(const int u) const { return m_offsets[u]; }
+  [[nodiscard]] int edgeEnd(const int u) const { return m_offsets[u + 1]; }
+  [[nodiscard]] int edgeTarget(const int e) const { return m_targets[e]; }
+  [[nodiscard]] float edgeCost(const int e) const { return m_costs[e]; }
+
+  // Directed edge id u->v, or -1 if not adjacent
+  [[nodiscard]] int findEdge(const int u, const int v) const {
+    for (int e = edgeBegin(u); e < edgeEnd(u); ++e)
+      if (m_targets[e] == v) return e;
+    return -1;
+  }
+
+  // Topology is frozen but costs may change (e.g. infinity for edges blocked by dynamic obstacles)
+  void setEdgeCost(const int e, const float cost) { m_costs[e] = cost; }
+
+  void clear() {
+    m_offsets.assign(1, 0);
+    m_targets.clear();
+    m_costs.clear();
+    m_x.clear();
+    m_y.clear();
+  }
+
+private:
+  friend class NavGraphFile; // saves/loads the arrays as they are
+
+  std::vector<int> m_offsets{ 0 }; // size() + 1 entries
+  std::vector<int> m_targets{};
+  std::vector<float> m_costs{};
+  std::vector<float> m_x{};
+  std::vector<float> m_y{};
+};
+
+} // namespace Pathfinding
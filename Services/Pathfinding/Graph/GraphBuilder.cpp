@@ -5,19 +5,31 @@
 
 namespace Pathfinding {
 
-void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles, Graph& outGraph)
-{
-    outGraph.clear();
+namespace {
+
+// Broadphase cell of the builder's obstacle tests (px)
+constexpr float kObstacleCellSize = 64.0f;
+
+// Breakpoints and centerlines shared by both builders
+struct CenterlineGrid {
+  std::vector<float> xs{}, ys{};             // sorted breakpoints (near-duplicates merged)
+  std::vector<float> centerXs{}, centerYs{};  // centerlines of the gaps wider than 2 units
+};
+
+} // namespace
 
-    // 1. Collect X/Y breakpoints from outer bounds and obstacles
-    std::vector<float> xs{ outer.minx, outer.maxx };
-    std::vector<float> ys{ outer.miny, outer.maxy };
+static void CollectCenterlines(const Rect& outer, const std::vector<Rect>& obstacles, CenterlineGrid& grid)
+{
+    std::vector<float>& xs = grid.xs;
+    std::vector<float>& ys = grid.ys;
+    xs = { outer.minx, outer.maxx };
+    ys = { outer.miny, outer.maxy };
     for (const auto& [minx, miny, maxx, maxy] : obstacles) {
         xs.push_back(minx); xs.push_back(maxx);
         ys.push_back(miny); ys.push_back(maxy);
     }
 
-    // 2. Sort and remove near-duplicate breakpoints (within 1e-3)
+    // Sort and remove near-duplicate breakpoints (within 1e-3)
     auto uniqSort = [](std::vector<float>& v) {
         std::ranges::sort(v);
         v.erase(std::ranges::unique(
@@ -28,25 +40,93 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
     uniqSort(xs);
     uniqSort(ys);
 
-    // 3. Compute centerlines (midpoints) between consecutive breakpoints.
-    //    Only keep centerlines for gaps wider than 2.0 units.
-    std::vector<float> centerXs; centerXs.reserve(xs.size());
-    for (size_t i = 0; i + 1 < xs.size(); ++i) {
-        const float a = xs[i], b = xs[i + 1];
-        if (b - a > 2.0f) centerXs.push_back((a + b) * 0.5f);
+    // Centerlines (midpoints) between consecutive breakpoints, only for gaps wider than 2.0 units
+    auto centers = [](const std::vector<float>& v, std::vector<float>& outCenters) {
+        outCenters.clear();
+        for (size_t i = 0; i + 1 < v.size(); ++i) {
+            const float a = v[i], b = v[i + 1];
+            if (b - a > 2.0f) outCenters.push_back((a + b) * 0.5f);
+        }
+    };
+    centers(xs, grid.centerXs);
+    centers(ys, grid.centerYs);
+}
+
+void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles, Graph& outGraph)
+{
+    outGraph.clear();
+    MutableGraph builder;
+
+    // 1-3. Breakpoints and centerlines (as in the reference builder)
+    CenterlineGrid grid;
+    CollectCenterlines(outer, obstacles, grid);
+    const int rows = static_cast<int>(grid.centerYs.size());
+    const int cols = static_cast<int>(grid.centerXs.size());
+    if (rows == 0 || cols == 0) return;
+
+    // Point and segment tests only look at the obstacles in the cells they touch
+    ObstacleSet blockers;
+    blockers.Build(obstacles, kObstacleCellSize);
+
+    std::vector<int> nodeIdx(rows * cols, -1);
+
+    // 4-5. Place nodes row by row (outside every obstacle, >1 unit inside the outer rect) and connect
+    //      each to the previous node of its row unless an obstacle lies between them
+    for (int r = 0; r < rows; ++r) {
+        const float y = grid.centerYs[r];
+        if (!(y > outer.miny + 1 && y < outer.maxy - 1)) continue;
+
+        int prevNode = -1;
+        for (int c = 0; c < cols; ++c) {
+            const Play::Vector2D p{ grid.centerXs[c], y };
+            if (!(p.x > outer.minx + 1 && p.x < outer.maxx - 1) || blockers.ContainsPoint(p)) continue;
+
+            const int idx = builder.addNode(p);
+            nodeIdx[r * cols + c] = idx;
+            if (prevNode >= 0) {
+                const Play::Vector2D prev = builder.nodes()[prevNode].pos;
+                if (!blockers.SegmentHitsAny(prev, p)) builder.addEdge(prevNode, idx, Geom::dist(prev, p));
+            }
+            prevNode = idx;
+        }
     }
 
-    std::vector<float> centerYs; centerYs.reserve(ys.size());
-    for (size_t i = 0; i + 1 < ys.size(); ++i) {
-        const float a = ys[i], b = ys[i + 1];
-        if (b - a > 2.0f) centerYs.push_back((a + b) * 0.5f);
+    // 6. Connect nodes vertically within each column the same way
+    for (int c = 0; c < cols; ++c) {
+        int prevNode = -1;
+        for (int r = 0; r < rows; ++r) {
+            const int idx = nodeIdx[r * cols + c];
+            if (idx < 0) continue;
+
+            if (prevNode >= 0) {
+                const Play::Vector2D prev = builder.nodes()[prevNode].pos, pos = builder.nodes()[idx].pos;
+                if (!blockers.SegmentHitsAny(prev, pos)) builder.addEdge(prevNode, idx, Geom::dist(prev, pos));
+            }
+            prevNode = idx;
+        }
     }
 
+    outGraph.assign(builder);
+}
+
+void BuildCenterlineGraphReference(const Rect& outer, const std::vector<Rect>& obstacles, Graph& outGraph)
+{
+    outGraph.clear();
+
+    // Build in the mutable adjacency form, then freeze into CSR at the end
+    MutableGraph builder;
+
+    // 1-3. Breakpoints and centerlines
+    CenterlineGrid grid;
+    CollectCenterlines(outer, obstacles, grid);
+    const std::vector<float>& centerXs = grid.centerXs;
+    const std::vector<float>& centerYs = grid.centerYs;
+
     const int rows = static_cast<int>(centerYs.size());
     const int cols = static_cast<int>(centerXs.size());
     if (rows == 0 || cols == 0) return;
 
-    // Map grid (row, col) -> node index in outGraph. Initialize to -1 (no node).
+    // Map grid (row, col) -> node index in builder. Initialize to -1 (no node).
     std::vector<int> nodeIdx(rows * cols, -1);
 
     // 4. Place nodes at centerline intersections:
@@ -68,7 +148,7 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
                 continue;
             }
 
-            nodeIdx[r * cols + c] = outGraph.addNode(p);
+            nodeIdx[r * cols + c] = builder.addNode(p);
         }
     }
 
@@ -87,7 +167,7 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
             const int idx = nodeIdx[r * cols + c];
             if (idx < 0) continue;
 
-            const auto& pos = outGraph.nodes()[idx].pos;
+            const auto& pos = builder.nodes()[idx].pos;
 
             if (!havePrev) {
                 // first node in this row
@@ -98,7 +178,7 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
                 // attempt to connect previous node to this one if no obstacle between them
                 if (!collides(prevPos, pos)) {
                     const float cost = Geom::dist(prevPos, pos);
-                    outGraph.addEdge(prevNode, idx, cost);
+                    builder.addEdge(prevNode, idx, cost);
                 }
                 // advance previous
                 prevNode = idx;
@@ -117,7 +197,7 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
             const int idx = nodeIdx[r * cols + c];
             if (idx < 0) continue;
 
-            const auto& pos = outGraph.nodes()[idx].pos;
+            const auto& pos = builder.nodes()[idx].pos;
 
             if (!havePrev) {
                 prevNode = idx;
@@ -126,13 +206,44 @@ void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles,
             } else {
                 if (!collides(prevPos, pos)) {
                     const float cost = Geom::dist(prevPos, pos);
-                    outGraph.addEdge(prevNode, idx, cost);
+                    builder.addEdge(prevNode, idx, cost);
                 }
                 prevNode = idx;
                 prevPos = pos;
             }
         }
     }
+
+    outGraph.assign(builder);
+}
+
+int LabelConnectedComponents(const Graph& g, std::vector<int>& outLabels)
+{
+    outLabels.assign(g.size(), -1);
+
+    // Flood fill from every unlabelled node; the stack is reused across components
+    std::vector<int> stack;
+    stack.reserve(g.size());
+    int count = 0;
+
+    for (int seed = 0; seed < g.size(); ++seed) {
+        if (outLabels[seed] >= 0) continue;
+
+        outLabels[seed] = count;
+        stack.push_back(seed);
+        while (!stack.empty()) {
+            const int u = stack.back();
+            stack.pop_back();
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                const int v = g.edgeTarget(e);
+                if (outLabels[v] >= 0 || g.edgeCost(e) == kBlockedCost) continue;
+                outLabels[v] = count;
+                stack.push_back(v);
+            }
+        }
+        ++count;
+    }
+    return count;
 }
 
-} // namespace Pathfinding
\ No newline at end of file
+} // namespace Pathfinding
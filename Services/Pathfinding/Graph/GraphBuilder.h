@@ -8,8 +8,19 @@
 
 namespace Pathfinding {
 
-// Build the rectilinear centerline graph inside 'outer', avoiding 'obstacles'.
+// Build the rectilinear centerline graph inside 'outer', avoiding 'obstacles', and freeze it into outGraph.
+// Point and segment tests go through a uniform grid over the obstacles, so each one only looks at the
+// obstacles in the cells it touches.
 void BuildCenterlineGraph(const Rect& outer, const std::vector<Rect>& obstacles, Graph& outGraph);
 
+// Straightforward builder testing every grid point and grid segment against every obstacle
+// (O(rows*cols*obstacles)). Produces the same graph; kept to check the grid builder against.
+void BuildCenterlineGraphReference(const Rect& outer, const std::vector<Rect>& obstacles, Graph& outGraph);
+
+// Label connected components: outLabels[n] is the component id of node n (0..count-1).
+// Blocked edges (kBlockedCost) do not connect.
+// Returns the number of components.
+int LabelConnectedComponents(const Graph& g, std::vector<int>& outLabels);
+
 } // namespace Pathfinding
 
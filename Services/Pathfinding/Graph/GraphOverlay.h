@@ -0,0 +1,130 @@
+#pragma once
+
+/// @brief Read-only view of a base graph with temporary start/goal nodes spliced into its edges.
+
+#include <array>
+#include <Play.h>
+#include "Graph.h"
+#include "Helper/Geometry.h"
+
+namespace Pathfinding {
+
+// Where a world point meets the base graph: either an existing node, or a point on edge (a,b).
+struct GraphAnchor {
+  int node{ -1 };        // base node index when snapped to a node, else -1
+  int a{ -1 };           // split edge endpoints (a < b) when not snapped
+  int b{ -1 };
+  float t{ 0.0f };       // parameter along a->b in [0,1]
+  Play::Vector2D pos{ 0.0f, 0.0f }; // world position of the anchor
+  bool blockedToA{ false };  // the stretch pos->a (resp. pos->b) crosses a dynamic obstacle
+  bool blockedToB{ false };
+
+  [[nodiscard]] bool valid() const { return node >= 0 || (a >= 0 && b >= 0); }
+  [[nodiscard]] bool onEdge() const { return node < 0 && a >= 0 && b >= 0; }
+};
+
+// Overlays up to two virtual nodes on an immutable base graph. Virtual nodes get the ids
+// base.size() and base.size()+1; the edge they sit on is replaced by the two split halves
+// when iterating neighbours, so nothing proportional to the graph size is copied.
+class GraphOverlay {
+public:
+  static constexpr int kMaxVirtual = 2;
+
+  explicit GraphOverlay(const Graph& base) : m_base(base) {}
+
+  // Attaches an anchor and returns the node id to search from/to (-1 if invalid or full).
+  int attach(const GraphAnchor& anchor) {
+    if (!anchor.valid()) return -1;
+    if (!anchor.onEdge()) return anchor.node;
+    if (m_count >= kMaxVirtual) return -1;
+
+    Virtual v{ anchor.a, anchor.b, anchor.t, anchor.pos, anchor.blockedToA, anchor.blockedToB };
+    if (v.a > v.b) { std::swap(v.a, v.b); std::swap(v.blockedToA, v.blockedToB); v.t = 1.0f - v.t; }
+    m_virtual[m_count] = v;
+    return m_base.size() + m_count++;
+  }
+
+  [[nodiscard]] int size() const { return m_base.size() + m_count; }
+  [[nodiscard]] const Graph& base() const { return m_base; }
+
+  [[nodiscard]] Play::Vector2D pos(const int n) const {
+    return n < m_base.size() ? m_base.pos(n) : m_virtual[n - m_base.size()].pos;
+  }
+
+  // Base edge (a < b) a virtual node sits on; false for base nodes
+  bool splitEdge(const int n, int& outA, int& outB) const {
+    if (n < m_base.size()) return false;
+    const Virtual& v = m_virtual[n - m_base.size()];
+    outA = v.a;
+    outB = v.b;
+    return true;
+  }
+
+  // Calls fn(to, cost) for every neighbour of node u, with split edges redirected through
+  // the virtual nodes that sit on them.
+  template <typename Fn>
+  void forEachNeighbor(const int u, Fn&& fn) const {
+    const int N = m_base.size();
+
+    if (u >= N) {
+      // Virtual node: neighbours are the closest points before/after it along its edge
+      const int k = u - N;
+      const Virtual& v = m_virtual[k];
+      int prev = v.a, next = v.b;
+      for (int j = 0; j < m_count; ++j) {
+        if (j == k || !sameEdge(m_virtual[j], v)) continue;
+        if (before(j, k) && (prev == v.a || before(prev - N, j))) prev = N + j;
+        if (before(k, j) && (next == v.b || before(j, next - N))) next = N + j;
+      }
+      // A stretch is closed if the obstacle lies between the two points; between two virtual
+      // nodes that is approximated (conservatively) by both facing sides being blocked
+      const bool prevBlocked = v.blockedToA && (prev == v.a || m_virtual[prev - N].blockedToB);
+      const bool nextBlocked = v.blockedToB && (next == v.b || m_virtual[next - N].blockedToA);
+      fn(prev, prevBlocked ? kBlockedCost : Geom::dist(pos(prev), v.pos));
+      fn(next, nextBlocked ? kBlockedCost : Geom::dist(v.pos, pos(next)));
+      return;
+    }
+
+    for (int e = m_base.edgeBegin(u); e < m_base.edgeEnd(u); ++e) {
+      const int to = m_base.edgeTarget(e);
+      const int lo = std::min(u, to), hi = std::max(u, to);
+
+      // Nearest virtual node on edge (u,to) as seen from u, if the edge is split
+      int split = -1;
+      for (int j = 0; j < m_count; ++j) {
+        if (m_virtual[j].a != lo || m_virtual[j].b != hi) continue;
+        if (split < 0 || (u == lo ? before(j, split) : before(split, j))) split = j;
+      }
+
+      if (split < 0) { fn(to, m_base.edgeCost(e)); continue; }
+
+      const Virtual& sv = m_virtual[split];
+      const bool blocked = (u == lo) ? sv.blockedToA : sv.blockedToB;
+      fn(N + split, blocked ? kBlockedCost : Geom::dist(m_base.pos(u), sv.pos));
+    }
+  }
+
+private:
+  struct Virtual {
+    int a{ -1 };
+    int b{ -1 };
+    float t{ 0.0f };
+    Play::Vector2D pos{ 0.0f, 0.0f };
+    bool blockedToA{ false };
+    bool blockedToB{ false };
+  };
+
+  [[nodiscard]] static bool sameEdge(const Virtual& x, const Virtual& y) { return x.a == y.a && x.b == y.b; }
+
+  // Strict ordering of two virtual nodes on the same edge (ties broken by slot)
+  [[nodiscard]] bool before(const int i, const int j) const {
+    const float ti = m_virtual[i].t, tj = m_virtual[j].t;
+    return ti < tj || (ti == tj && i < j);
+  }
+
+  const Graph& m_base;
+  std::array<Virtual, kMaxVirtual> m_virtual{};
+  int m_count{ 0 };
+};
+
+} // namespace Pathfinding
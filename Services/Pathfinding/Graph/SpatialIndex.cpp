@@ -0,0 +1,171 @@
+#include "SpatialIndex.h"
+#include "Graph.h"
+#include "Helper/Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Pathfinding {
+
+void SpatialIndex::clear()
+{
+    m_cols = m_rows = 0;
+    m_nodeCellStart.clear();
+    m_nodeItems.clear();
+    m_edgeCellStart.clear();
+    m_edgeItems.clear();
+    m_edges.clear();
+}
+
+int SpatialIndex::cellX(const float x) const
+{
+    return std::clamp(static_cast<int>(std::floor((x - m_originX) / m_cellSize)), 0, m_cols - 1);
+}
+
+int SpatialIndex::cellY(const float y) const
+{
+    return std::clamp(static_cast<int>(std::floor((y - m_originY) / m_cellSize)), 0, m_rows - 1);
+}
+
+void SpatialIndex::Build(const Graph& g, const float cellSize)
+{
+    clear();
+    if (g.size() == 0) return;
+
+    m_cellSize = std::max(1.0f, cellSize);
+
+    // 1. Grid bounds from node extents (edges never leave the node bounding box)
+    float minx = g.x(0), maxx = g.x(0), miny = g.y(0), maxy = g.y(0);
+    for (int i = 1; i < g.size(); ++i) {
+        minx = std::min(minx, g.x(i)); maxx = std::max(maxx, g.x(i));
+        miny = std::min(miny, g.y(i)); maxy = std::max(maxy, g.y(i));
+    }
+    m_originX = minx;
+    m_originY = miny;
+    m_cols = static_cast<int>((maxx - minx) / m_cellSize) + 1;
+    m_rows = static_cast<int>((maxy - miny) / m_cellSize) + 1;
+    const int cells = m_cols * m_rows;
+
+    // 2. Cache unique undirected edges (u < v)
+    m_edges.reserve(g.edgeCount() / 2);
+    for (int u = 0; u < g.size(); ++u) {
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const int v = g.edgeTarget(e);
+            if (u < v) m_edges.emplace_back(u, v);
+        }
+    }
+
+    // 3. Bucket nodes: count per cell, prefix sum, then fill
+    m_nodeCellStart.assign(cells + 1, 0);
+    for (int i = 0; i < g.size(); ++i) m_nodeCellStart[cellY(g.y(i)) * m_cols + cellX(g.x(i)) + 1]++;
+    for (int c = 0; c < cells; ++c) m_nodeCellStart[c + 1] += m_nodeCellStart[c];
+    m_nodeItems.resize(g.size());
+    {
+        std::vector<int> cursor(m_nodeCellStart.begin(), m_nodeCellStart.end() - 1);
+        for (int i = 0; i < g.size(); ++i) m_nodeItems[cursor[cellY(g.y(i)) * m_cols + cellX(g.x(i))]++] = i;
+    }
+
+    // 4. Bucket edges into every cell their bounding box overlaps (same two-pass fill)
+    auto forEachEdgeCell = [&](const int id, auto&& fn) {
+        const auto [a, b] = m_edges[id];
+        const int c0 = cellX(std::min(g.x(a), g.x(b))), c1 = cellX(std::max(g.x(a), g.x(b)));
+        const int r0 = cellY(std::min(g.y(a), g.y(b))), r1 = cellY(std::max(g.y(a), g.y(b)));
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c) fn(r * m_cols + c);
+    };
+
+    m_edgeCellStart.assign(cells + 1, 0);
+    for (int id = 0; id < static_cast<int>(m_edges.size()); ++id)
+        forEachEdgeCell(id, [&](const int cell) { m_edgeCellStart[cell + 1]++; });
+    for (int c = 0; c < cells; ++c) m_edgeCellStart[c + 1] += m_edgeCellStart[c];
+    m_edgeItems.resize(m_edgeCellStart[cells]);
+    {
+        std::vector<int> cursor(m_edgeCellStart.begin(), m_edgeCellStart.end() - 1);
+        for (int id = 0; id < static_cast<int>(m_edges.size()); ++id)
+            forEachEdgeCell(id, [&](const int cell) { m_edgeItems[cursor[cell]++] = id; });
+    }
+}
+
+int SpatialIndex::NearestNode(const Graph& g, const Play::Vector2D& p, const float maxDist) const
+{
+    if (empty()) return -1;
+
+    // Only cells overlapping the search circle's bounding box can hold a candidate
+    const int c0 = cellX(p.x - maxDist), c1 = cellX(p.x + maxDist);
+    const int r0 = cellY(p.y - maxDist), r1 = cellY(p.y + maxDist);
+
+    int best = -1;
+    float bestD2 = maxDist * maxDist;
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            const int cell = r * m_cols + c;
+            for (int k = m_nodeCellStart[cell]; k < m_nodeCellStart[cell + 1]; ++k) {
+                const int i = m_nodeItems[k];
+                const float d2 = Geom::dist2(p, g.pos(i));
+                if (d2 <= bestD2) { bestD2 = d2; best = i; }
+            }
+        }
+    }
+    return best;
+}
+
+void SpatialIndex::EdgesInBox(const float minx, const float miny, const float maxx, const float maxy, std::vector<int>& outEdgeIds) const
+{
+    outEdgeIds.clear();
+    if (empty()) return;
+
+    const int c0 = cellX(minx), c1 = cellX(maxx);
+    const int r0 = cellY(miny), r1 = cellY(maxy);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            const int cell = r * m_cols + c;
+            outEdgeIds.insert(outEdgeIds.end(), m_edgeItems.begin() + m_edgeCellStart[cell], m_edgeItems.begin() + m_edgeCellStart[cell + 1]);
+        }
+    }
+
+    // Long edges are bucketed in several cells
+    std::ranges::sort(outEdgeIds);
+    outEdgeIds.erase(std::ranges::unique(outEdgeIds).begin(), outEdgeIds.end());
+}
+
+bool SpatialIndex::NearestEdge(const Graph& g, const Play::Vector2D& p, EdgeHit& out) const
+{
+    if (empty() || m_edges.empty()) return false;
+
+    const int pc = cellX(p.x), pr = cellY(p.y);
+    const int maxRing = std::max(m_cols, m_rows);
+    out.dist2 = std::numeric_limits<float>::infinity();
+    out.a = -1;
+
+    auto testCell = [&](const int c, const int r) {
+        const int cell = r * m_cols + c;
+        for (int k = m_edgeCellStart[cell]; k < m_edgeCellStart[cell + 1]; ++k) {
+            const auto [a, b] = m_edges[m_edgeItems[k]];
+            float t;
+            const Play::Vector2D q = Geom::projectOnSegment(p, g.pos(a), g.pos(b), t);
+            const float d2 = Geom::dist2(p, q);
+            if (d2 < out.dist2) { out = EdgeHit{ a, b, t, q, d2 }; }
+        }
+    };
+
+    // Expand square rings around p's cell. Anything outside ring r is at least r*cellSize away,
+    // so stop as soon as the best hit is closer than that.
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        const int c0 = pc - ring, c1 = pc + ring, r0 = pr - ring, r1 = pr + ring;
+        for (int r = std::max(r0, 0); r <= std::min(r1, m_rows - 1); ++r) {
+            if (r == r0 || r == r1) {
+                for (int c = std::max(c0, 0); c <= std::min(c1, m_cols - 1); ++c) testCell(c, r);
+            } else {
+                // Interior rows were covered by smaller rings; only the left/right borders are new
+                if (c0 >= 0) testCell(c0, r);
+                if (c1 < m_cols) testCell(c1, r);
+            }
+        }
+
+        const float reach = static_cast<float>(ring) * m_cellSize;
+        if (out.a >= 0 && out.dist2 <= reach * reach) break;
+    }
+    return out.a >= 0;
+}
+
+} // namespace Pathfinding
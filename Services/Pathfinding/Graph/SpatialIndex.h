@@ -0,0 +1,64 @@
+#pragma once
+
+/// @brief Uniform-grid index over graph nodes and edge segments for nearest-node / nearest-edge snapping.
+
+#include <vector>
+#include <utility>
+#include <Play.h>
+
+namespace Pathfinding {
+
+class Graph;
+
+// Built once per graph (PathfinderService::Rebuild). Cells are stored CSR-style:
+// items of cell c are [cellStart[c], cellStart[c+1]) in the item array.
+// Queries are read-only and safe to run concurrently.
+class SpatialIndex {
+public:
+  // Result of a nearest-edge query: undirected edge (a,b), parameter t along a->b and the projected point
+  struct EdgeHit {
+    int a{ -1 };
+    int b{ -1 };
+    float t{ 0.0f };
+    Play::Vector2D pos{ 0.0f, 0.0f };
+    float dist2{ 0.0f };
+  };
+
+  void Build(const Graph& g, float cellSize);
+  void clear();
+
+  [[nodiscard]] bool empty() const { return m_cols == 0 || m_rows == 0; }
+
+  // Nearest node within maxDist of p, or -1 if none
+  [[nodiscard]] int NearestNode(const Graph& g, const Play::Vector2D& p, float maxDist) const;
+
+  // Closest point on any edge to p. Returns false only when the graph has no edges.
+  bool NearestEdge(const Graph& g, const Play::Vector2D& p, EdgeHit& out) const;
+
+  // Ids (into Edges()) of edges whose bucket cells overlap the box, sorted and unique.
+  // A superset of the edges actually crossing the box; callers do the exact test.
+  void EdgesInBox(float minx, float miny, float maxx, float maxy, std::vector<int>& outEdgeIds) const;
+
+  // Cached unique undirected edges (u < v); the edge id used by the index is the position in this list
+  [[nodiscard]] const std::vector<std::pair<int, int>>& Edges() const { return m_edges; }
+
+private:
+  friend class NavGraphFile; // saves/loads the arrays as they are
+
+  [[nodiscard]] int cellX(float x) const;
+  [[nodiscard]] int cellY(float y) const;
+
+  float m_cellSize{ 64.0f };
+  float m_originX{ 0.0f };
+  float m_originY{ 0.0f };
+  int m_cols{ 0 };
+  int m_rows{ 0 };
+
+  std::vector<int> m_nodeCellStart{};
+  std::vector<int> m_nodeItems{};
+  std::vector<int> m_edgeCellStart{};
+  std::vector<int> m_edgeItems{};
+  std::vector<std::pair<int, int>> m_edges{};
+};
+
+} // namespace Pathfinding
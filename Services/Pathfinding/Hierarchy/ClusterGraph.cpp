@@ -0,0 +1,369 @@
+#include "ClusterGraph.h"
+#include "Pathfinding/AStar/AStar.h"
+#include "Pathfinding/AStar/SearchContext.h"
+#include "Helper/Geometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Pathfinding {
+
+// Dijkstra from 'sources' that never leaves 'cluster'; distances are left in ctx.gScore.
+// With stopAfter > 0 it stops once that many entrances of the cluster have been settled.
+static void SearchCluster(const Graph& g, const std::vector<int>& clusterOf, const std::vector<int>& entranceOf, const int cluster,
+                          const std::span<const NodeTerminal> sources, SearchContext& ctx, const int stopAfter = 0)
+{
+    ctx.begin(g.size());
+    for (const auto& [node, cost] : sources) {
+        if (cost < ctx.gScore(node)) {
+            ctx.setScore(node, cost, -1);
+            ctx.pushOpen(node, cost);
+        }
+    }
+
+    int settledEntrances = 0;
+    while (!ctx.openEmpty()) {
+        const int u = ctx.popOpen().node;
+        if (ctx.isClosed(u)) continue;
+        ctx.close(u);
+        if (entranceOf[u] >= 0 && ++settledEntrances == stopAfter) return;
+
+        const float gu = ctx.gScore(u);
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const int v = g.edgeTarget(e);
+            if (clusterOf[v] != cluster || ctx.isClosed(v)) continue;
+            const float tentative = gu + g.edgeCost(e);
+            if (tentative < ctx.gScore(v)) {
+                ctx.setScore(v, tentative, u);
+                ctx.pushOpen(v, tentative);
+            }
+        }
+    }
+}
+
+// Source node of a directed edge id (the graph only stores targets)
+static int EdgeSource(const Graph& g, const int e)
+{
+    int lo = 0, hi = g.size() - 1;
+    while (lo < hi) {
+        const int mid = (lo + hi + 1) / 2;
+        if (g.edgeBegin(mid) <= e) lo = mid; else hi = mid - 1;
+    }
+    return lo;
+}
+
+void ClusterGraph::LabelClusterRegions(const Graph& g, std::vector<int>& outRegion) const
+{
+    outRegion.assign(g.size(), -1);
+    std::vector<int> stack;
+    int next = 0;
+    for (int seed = 0; seed < g.size(); ++seed) {
+        if (outRegion[seed] >= 0) continue;
+        outRegion[seed] = next;
+        stack.push_back(seed);
+        while (!stack.empty()) {
+            const int u = stack.back();
+            stack.pop_back();
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                const int v = g.edgeTarget(e);
+                if (outRegion[v] >= 0 || m_clusterOf[v] != m_clusterOf[u] || g.edgeCost(e) == kBlockedCost) continue;
+                outRegion[v] = next;
+                stack.push_back(v);
+            }
+        }
+        ++next;
+    }
+}
+
+void ClusterGraph::clear()
+{
+    m_cols = 0;
+    m_clusterOf.clear();
+    m_entranceOf.clear();
+    m_entranceNode.clear();
+    m_clusterStart.clear();
+    m_edgeOffsets.clear();
+    m_intraBegin.clear();
+    m_edgeTarget.clear();
+    m_edgeBase.clear();
+    m_edgeCost.clear();
+}
+
+void ClusterGraph::Build(const Graph& g, const float clusterSize)
+{
+    clear();
+    const int n = g.size();
+    if (n == 0) return;
+
+    // 1. Square clusters over the node bounding box
+    m_clusterSize = std::max(1.0f, clusterSize);
+    float minx = g.x(0), maxx = g.x(0), miny = g.y(0), maxy = g.y(0);
+    for (int i = 1; i < n; ++i) {
+        minx = std::min(minx, g.x(i)); maxx = std::max(maxx, g.x(i));
+        miny = std::min(miny, g.y(i)); maxy = std::max(maxy, g.y(i));
+    }
+    m_originX = minx;
+    m_originY = miny;
+    m_cols = static_cast<int>((maxx - minx) / m_clusterSize) + 1;
+    const int rows = static_cast<int>((maxy - miny) / m_clusterSize) + 1;
+    const int clusters = m_cols * rows;
+
+    m_clusterOf.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const int cx = std::clamp(static_cast<int>((g.x(i) - m_originX) / m_clusterSize), 0, m_cols - 1);
+        const int cy = std::clamp(static_cast<int>((g.y(i) - m_originY) / m_clusterSize), 0, rows - 1);
+        m_clusterOf[i] = cy * m_cols + cx;
+    }
+
+    // 2. Transitions. Crossing edges are grouped by the pair of regions they join (a region is the
+    //    part of a cluster connected inside it) and by which of kBorderSegments stretches of the
+    //    cluster border they cross; the one closest to the middle of its stretch represents the group.
+    //    Both ends of a transition become entrances.
+    std::vector<int> region;
+    LabelClusterRegions(g, region);
+
+    struct Crossing { int lo, hi, segment; float offCentre; int edge; };
+    std::vector<Crossing> crossings;
+    for (int u = 0; u < n; ++u) {
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const int v = g.edgeTarget(e);
+            if (v < u || m_clusterOf[v] == m_clusterOf[u]) continue;
+
+            // Position along the shared border, in cluster sizes (0 for corners and long edges)
+            const int cu = m_clusterOf[u], cv = m_clusterOf[v];
+            const Play::Vector2D mid = (g.pos(u) + g.pos(v)) * 0.5f;
+            float along = 0.5f;
+            if (cu / m_cols == cv / m_cols && std::abs(cu - cv) == 1)
+                along = (mid.y - m_originY) / m_clusterSize - static_cast<float>(cu / m_cols);
+            else if (cu % m_cols == cv % m_cols && std::abs(cu - cv) == m_cols)
+                along = (mid.x - m_originX) / m_clusterSize - static_cast<float>(cu % m_cols);
+            const float scaled = std::clamp(along, 0.0f, 0.999f) * kBorderSegments;
+            const int segment = static_cast<int>(scaled);
+            crossings.push_back({ std::min(region[u], region[v]), std::max(region[u], region[v]), segment,
+                                  std::abs(scaled - static_cast<float>(segment) - 0.5f), e });
+        }
+    }
+    std::ranges::sort(crossings, [](const Crossing& a, const Crossing& b) {
+        if (a.lo != b.lo) return a.lo < b.lo;
+        if (a.hi != b.hi) return a.hi < b.hi;
+        if (a.segment != b.segment) return a.segment < b.segment;
+        return a.offCentre < b.offCentre;
+    });
+
+    std::vector<int> transitions; // directed edge ids, both directions
+    for (size_t i = 0; i < crossings.size(); ++i) {
+        const Crossing& c = crossings[i];
+        if (i > 0 && crossings[i - 1].lo == c.lo && crossings[i - 1].hi == c.hi && crossings[i - 1].segment == c.segment) continue;
+        const int u = EdgeSource(g, c.edge), v = g.edgeTarget(c.edge);
+        transitions.push_back(c.edge);
+        transitions.push_back(g.findEdge(v, u));
+    }
+    std::ranges::sort(transitions);
+
+    // Entrances grouped by cluster (count, prefix sum, fill)
+    m_entranceOf.assign(n, -1);
+    for (const int e : transitions) m_entranceOf[g.edgeTarget(e)] = 0; // both directions are listed
+    m_clusterStart.assign(clusters + 1, 0);
+    for (int u = 0; u < n; ++u)
+        if (m_entranceOf[u] == 0) m_clusterStart[m_clusterOf[u] + 1]++;
+    for (int c = 0; c < clusters; ++c) m_clusterStart[c + 1] += m_clusterStart[c];
+    m_entranceNode.resize(m_clusterStart[clusters]);
+    {
+        std::vector<int> cursor(m_clusterStart.begin(), m_clusterStart.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            if (m_entranceOf[u] < 0) continue;
+            const int id = cursor[m_clusterOf[u]]++;
+            m_entranceNode[id] = u;
+            m_entranceOf[u] = id;
+        }
+    }
+    auto isTransition = [&transitions](const int e) { return std::ranges::binary_search(transitions, e); };
+
+    // 3. Abstract edges: transitions, then every other entrance of the same cluster
+    const int entrances = EntranceCount();
+    m_edgeOffsets.assign(entrances + 1, 0);
+    m_intraBegin.resize(entrances);
+    for (int id = 0; id < entrances; ++id) {
+        const int u = m_entranceNode[id], c = m_clusterOf[u];
+        int cross = 0;
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) cross += isTransition(e);
+        const int intra = m_clusterStart[c + 1] - m_clusterStart[c] - 1;
+        m_edgeOffsets[id + 1] = m_edgeOffsets[id] + cross + intra;
+        m_intraBegin[id] = m_edgeOffsets[id] + cross;
+    }
+    m_edgeTarget.resize(m_edgeOffsets[entrances]);
+    m_edgeBase.resize(m_edgeOffsets[entrances]);
+    m_edgeCost.assign(m_edgeOffsets[entrances], kBlockedCost);
+    for (int id = 0; id < entrances; ++id) {
+        const int u = m_entranceNode[id], c = m_clusterOf[u];
+        int k = m_edgeOffsets[id];
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            if (!isTransition(e)) continue;
+            m_edgeTarget[k] = m_entranceOf[g.edgeTarget(e)];
+            m_edgeBase[k++] = e;
+        }
+        for (int other = m_clusterStart[c]; other < m_clusterStart[c + 1]; ++other) {
+            if (other == id) continue;
+            m_edgeTarget[k] = other;
+            m_edgeBase[k++] = -1;
+        }
+    }
+
+    // 4. Intra-cluster distances
+    SearchContext ctx;
+    for (int c = 0; c < clusters; ++c) ComputeClusterCosts(g, c, ctx);
+}
+
+void ClusterGraph::ComputeClusterCosts(const Graph& g, const int cluster, SearchContext& ctx)
+{
+    const int first = m_clusterStart[cluster], last = m_clusterStart[cluster + 1];
+    if (last - first < 2) return;
+
+    for (int id = first; id < last; ++id) {
+        const NodeTerminal source{ m_entranceNode[id], 0.0f };
+        SearchCluster(g, m_clusterOf, m_entranceOf, cluster, { &source, 1 }, ctx, last - first);
+
+        // Intra edges follow the cluster's entrance order, skipping the entrance itself
+        int k = m_intraBegin[id];
+        for (int other = first; other < last; ++other) {
+            if (other != id) m_edgeCost[k++] = ctx.gScore(m_entranceNode[other]);
+        }
+    }
+}
+
+void ClusterGraph::UpdateCosts(const Graph& g, const std::span<const std::pair<int, int>> changedEdges)
+{
+    if (empty()) return;
+
+    std::vector<int> clusters;
+    for (const auto& [u, v] : changedEdges) {
+        clusters.push_back(m_clusterOf[u]);
+        clusters.push_back(m_clusterOf[v]);
+    }
+    std::ranges::sort(clusters);
+    clusters.erase(std::ranges::unique(clusters).begin(), clusters.end());
+
+    // Cross-cluster edges read their cost live; only paths inside the touched clusters can change
+    SearchContext ctx;
+    for (const int c : clusters) ComputeClusterCosts(g, c, ctx);
+}
+
+bool ClusterGraph::FindRoute(const Graph& g, const std::span<const NodeTerminal> starts, const std::span<const NodeTerminal> goals,
+                             const Play::Vector2D& goalPos, SearchContext& ctx, std::vector<int>& outNodes, float& outCost) const
+{
+    outNodes.clear();
+    if (empty()) return false;
+
+    // 1. Connect the terminals to the entrances of their clusters (and to each other when they share one).
+    //    Searches are seeded with the terminal costs, so distances include them.
+    struct Link { int entrance; float cost; int terminal; };
+    std::vector<Link> startLinks, goalLinks;
+    float direct = kBlockedCost;
+    int directFrom = -1, directTo = -1;
+
+    for (const NodeTerminal& s : starts) {
+        if (s.node < 0 || s.cost == kBlockedCost) continue;
+        const int c = m_clusterOf[s.node];
+        SearchCluster(g, m_clusterOf, m_entranceOf, c, { &s, 1 }, ctx);
+        for (int id = m_clusterStart[c]; id < m_clusterStart[c + 1]; ++id) {
+            const float d = ctx.gScore(m_entranceNode[id]);
+            if (d < kBlockedCost) startLinks.push_back({ id, d, s.node });
+        }
+        for (const NodeTerminal& t : goals) {
+            if (t.node < 0 || m_clusterOf[t.node] != c) continue;
+            const float d = ctx.gScore(t.node) + t.cost;
+            if (d < direct) { direct = d; directFrom = s.node; directTo = t.node; }
+        }
+    }
+    for (const NodeTerminal& t : goals) {
+        if (t.node < 0 || t.cost == kBlockedCost) continue;
+        const int c = m_clusterOf[t.node];
+        SearchCluster(g, m_clusterOf, m_entranceOf, c, { &t, 1 }, ctx);
+        for (int id = m_clusterStart[c]; id < m_clusterStart[c + 1]; ++id) {
+            const float d = ctx.gScore(m_entranceNode[id]);
+            if (d < kBlockedCost) goalLinks.push_back({ id, d, t.node });
+        }
+    }
+
+    // 2. A* over the entrances; node 'goal' stands for the goal point
+    const int goal = EntranceCount();
+    auto h = [&](const int id) { return Geom::dist(g.pos(m_entranceNode[id]), goalPos); };
+
+    ctx.begin(goal + 1);
+    for (const Link& l : startLinks) {
+        if (l.cost < ctx.gScore(l.entrance)) {
+            ctx.setScore(l.entrance, l.cost, -1);
+            ctx.pushOpen(l.entrance, l.cost + h(l.entrance));
+        }
+    }
+    if (direct < kBlockedCost) {
+        ctx.setScore(goal, direct, -1);
+        ctx.pushOpen(goal, direct);
+    }
+
+    while (!ctx.openEmpty()) {
+        const int cur = ctx.popOpen().node;
+        if (ctx.isClosed(cur)) continue;
+        ctx.close(cur);
+        if (cur == goal) break;
+
+        const float gCur = ctx.gScore(cur);
+        auto relax = [&](const int to, const float tentative, const float heuristic) {
+            if (ctx.isClosed(to) || !(tentative < ctx.gScore(to))) return;
+            ctx.setScore(to, tentative, cur);
+            ctx.pushOpen(to, tentative + heuristic);
+        };
+        for (int k = m_edgeOffsets[cur]; k < m_edgeOffsets[cur + 1]; ++k) {
+            const float cost = m_edgeBase[k] >= 0 ? g.edgeCost(m_edgeBase[k]) : m_edgeCost[k];
+            if (cost < kBlockedCost) relax(m_edgeTarget[k], gCur + cost, h(m_edgeTarget[k]));
+        }
+        for (const Link& l : goalLinks)
+            if (l.entrance == cur) relax(goal, gCur + l.cost, 0.0f);
+    }
+    if (!ctx.isClosed(goal)) return false;
+    outCost = ctx.gScore(goal);
+
+    // 3. Unwind: start terminal, entrances, goal terminal
+    auto cheapest = [](const std::vector<Link>& links, const int entrance) {
+        const Link* best = nullptr;
+        for (const Link& l : links)
+            if (l.entrance == entrance && (!best || l.cost < best->cost)) best = &l;
+        return best->terminal;
+    };
+    auto pushNode = [&outNodes](const int node) {
+        if (outNodes.empty() || outNodes.back() != node) outNodes.push_back(node);
+    };
+
+    const int lastEntrance = ctx.cameFrom(goal);
+    if (lastEntrance < 0) {
+        pushNode(directFrom);
+        pushNode(directTo);
+        return true;
+    }
+
+    std::vector<int> chain;
+    for (int id = lastEntrance; id >= 0; id = ctx.cameFrom(id)) chain.push_back(id);
+    pushNode(cheapest(startLinks, chain.back()));
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) pushNode(m_entranceNode[*it]);
+    pushNode(cheapest(goalLinks, lastEntrance));
+    return true;
+}
+
+bool ClusterGraph::RefineHop(const Graph& g, const int from, const int to, SearchContext& ctx, std::vector<int>& outNodes) const
+{
+    if (from == to) return true;
+
+    // Between clusters a hop is a single base edge
+    if (m_clusterOf[from] != m_clusterOf[to]) {
+        const int e = g.findEdge(from, to);
+        if (e < 0 || g.edgeCost(e) == kBlockedCost) return false;
+        outNodes.push_back(to);
+        return true;
+    }
+
+    std::vector<int>& hop = ctx.scratchPath();
+    if (!FindPathInRegion(g, m_clusterOf, m_clusterOf[from], from, to, ctx, hop)) return false;
+    outNodes.insert(outNodes.end(), hop.begin() + 1, hop.end());
+    return true;
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @brief HPA*-style abstraction of the nav graph: square clusters linked through their entrance nodes.
+
+#include "Pathfinding/Graph/Graph.h"
+#include <vector>
+#include <span>
+#include <utility>
+#include <Play.h>
+
+namespace Pathfinding {
+
+class SearchContext;
+
+// Nodes are bucketed into square clusters by position. Edges between clusters are thinned to a few
+// transitions per stretch of border (HPA*), whose end nodes are the entrances. The abstract graph links
+//   - every pair of entrances of a cluster, at their shortest distance inside the cluster, and
+//   - the two entrances of each transition, at that edge's live cost.
+// Long queries search the abstract graph; each abstract hop is refined later by a search confined
+// to one cluster. Routes are near-optimal (they only cross borders at transitions).
+// Read-only after Build/UpdateCosts, so queries may run concurrently.
+class ClusterGraph {
+public:
+  void Build(const Graph& g, float clusterSize);
+  void clear();
+  [[nodiscard]] bool empty() const { return m_clusterOf.empty(); }
+
+  // Re-derives the intra-cluster distances of the clusters touching the given edges
+  // (call after their costs changed; the abstract topology does not change)
+  void UpdateCosts(const Graph& g, std::span<const std::pair<int, int>> changedEdges);
+
+  [[nodiscard]] int ClusterOf(const int node) const { return m_clusterOf[node]; }
+  [[nodiscard]] const std::vector<int>& Clusters() const { return m_clusterOf; }
+  [[nodiscard]] int EntranceCount() const { return static_cast<int>(m_entranceNode.size()); }
+
+  // Best route from any start terminal to any goal terminal through the abstract graph.
+  // outNodes = [start node, entrances..., goal node] with consecutive duplicates removed; every
+  // consecutive pair is one abstract hop. False if the goal cannot be reached.
+  bool FindRoute(const Graph& g, std::span<const NodeTerminal> starts, std::span<const NodeTerminal> goals,
+                 const Play::Vector2D& goalPos, SearchContext& ctx, std::vector<int>& outNodes, float& outCost) const;
+
+  // Appends the base nodes after 'from' up to and including 'to' for one abstract hop.
+  // False if the hop is no longer passable (edge costs changed since it was planned).
+  bool RefineHop(const Graph& g, int from, int to, SearchContext& ctx, std::vector<int>& outNodes) const;
+
+private:
+  // Labels the parts of each cluster that are connected inside it (transitions are picked per pair of them)
+  void LabelClusterRegions(const Graph& g, std::vector<int>& outRegion) const;
+
+  // Shortest distances inside the cluster from every entrance to every other entrance
+  void ComputeClusterCosts(const Graph& g, int cluster, SearchContext& ctx);
+
+  // Transitions kept per border between two regions (one per stretch, closest to its middle)
+  static constexpr int kBorderSegments = 3;
+
+  float m_clusterSize{ 256.0f };
+  float m_originX{ 0.0f };
+  float m_originY{ 0.0f };
+  int m_cols{ 0 };
+
+  std::vector<int> m_clusterOf{};       // per base node
+  std::vector<int> m_entranceOf{};      // per base node: entrance id or -1
+  std::vector<int> m_entranceNode{};    // per entrance: base node (grouped by cluster)
+  std::vector<int> m_clusterStart{};    // entrances of cluster c are [m_clusterStart[c], m_clusterStart[c+1])
+
+  // Abstract edges in CSR form per entrance: transitions first, then one per other
+  // entrance of the same cluster (in cluster order)
+  std::vector<int> m_edgeOffsets{};
+  std::vector<int> m_intraBegin{};      // per entrance: first intra edge
+  std::vector<int> m_edgeTarget{};      // entrance id
+  std::vector<int> m_edgeBase{};        // base edge id for transitions, -1 for intra edges
+  std::vector<float> m_edgeCost{};      // intra edges only (transition costs are read live)
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,24 @@
+#pragma once
+
+/// @brief Tail of a hierarchical plan that has not been refined into waypoints yet.
+
+#include <Play.h>
+#include <vector>
+#include <cstdint>
+
+namespace Pathfinding {
+
+// Graph nodes the path still has to pass through after the refined polyline ends, one abstract
+// hop apart (within a cluster, or across one edge between clusters). Refined a few hops at a time
+// by PathfinderService::RefineRoute as the follower approaches the end of the polyline.
+struct PendingRoute {
+  std::vector<int> nodes{};          // nodes[0] is the node the refined polyline currently ends at
+  Play::Vector2D goal{ 0.0f, 0.0f }; // final point of the whole path
+  bool goalOffNode{ false };         // goal lies mid-edge: append it after the last node
+  std::uint32_t graphVersion{ 0 };  // rebuild of the nav graph the node ids belong to
+
+  [[nodiscard]] bool empty() const { return nodes.size() < 2 && !goalOffNode; }
+  void clear() { nodes.clear(); goalOffNode = false; }
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,173 @@
+#include "DStarLite.h"
+#include "Pathfinding/Graph/Graph.h"
+#include "Helper/Geometry.h"
+#include <algorithm>
+
+namespace Pathfinding {
+
+void DStarLite::Clear()
+{
+    m_graph = nullptr;
+    m_g.clear();
+    m_rhs.clear();
+    m_goalCost.clear();
+    m_goals.clear();
+    m_open.clear();
+    m_starts.clear();
+    m_km = 0.0f;
+}
+
+void DStarLite::Init(const Graph& g, const std::span<const Terminal> goals)
+{
+    Clear();
+    m_graph = &g;
+    m_g.assign(g.size(), kBlockedCost);
+    m_rhs.assign(g.size(), kBlockedCost);
+    m_goalCost.assign(g.size(), kBlockedCost);
+    SetGoals(goals);
+}
+
+void DStarLite::SetGoals(const std::span<const Terminal> goals)
+{
+    if (!m_graph) return;
+    const std::vector<Terminal> previous = std::move(m_goals);
+    m_goals.clear();
+
+    for (const auto& [node, cost] : previous) m_goalCost[node] = kBlockedCost;
+    for (const auto& goal : goals) {
+        if (goal.node < 0 || goal.node >= m_graph->size()) continue;
+        m_goalCost[goal.node] = std::min(m_goalCost[goal.node], goal.cost);
+        m_goals.push_back(goal);
+    }
+
+    for (const auto& [node, cost] : previous) updateVertex(node);
+    for (const auto& [node, cost] : m_goals) updateVertex(node);
+}
+
+void DStarLite::SetStart(const Play::Vector2D& startPos, const std::span<const Terminal> starts)
+{
+    // Keys already in the heap were computed against the old start; shifting every future key
+    // by the distance moved keeps them comparable without re-keying the heap
+    if (!m_starts.empty()) m_km += Geom::dist(m_startPos, startPos);
+    m_startPos = startPos;
+    m_starts.assign(starts.begin(), starts.end());
+}
+
+float DStarLite::h(const int n) const
+{
+    return Geom::dist(m_startPos, m_graph->pos(n));
+}
+
+DStarLite::Key DStarLite::calcKey(const int n) const
+{
+    const float m = std::min(m_g[n], m_rhs[n]);
+    return { m + h(n) + m_km, m };
+}
+
+void DStarLite::push(const int n)
+{
+    m_open.push_back({ calcKey(n), n });
+    std::ranges::push_heap(m_open, greaterKey);
+}
+
+void DStarLite::updateVertex(const int n)
+{
+    // rhs = best one-step lookahead towards the goal set
+    float best = m_goalCost[n];
+    const Graph& g = *m_graph;
+    for (int e = g.edgeBegin(n); e < g.edgeEnd(n); ++e)
+        best = std::min(best, g.edgeCost(e) + m_g[g.edgeTarget(e)]);
+    m_rhs[n] = best;
+
+    if (m_g[n] != m_rhs[n]) push(n);
+}
+
+void DStarLite::EdgesChanged(const std::span<const std::pair<int, int>> edges)
+{
+    if (!m_graph) return;
+    for (const auto& [u, v] : edges) {
+        if (u < 0 || v < 0 || u >= m_graph->size() || v >= m_graph->size()) continue;
+        updateVertex(u);
+        updateVertex(v);
+    }
+}
+
+bool DStarLite::startsSettled() const
+{
+    if (m_open.empty()) return true;
+
+    // The start set acts as one virtual start node linked to each start by its cost
+    // (h is 0 there, and h stays admissible since it measures from the start point)
+    float g = kBlockedCost, rhs = kBlockedCost;
+    for (const auto& [node, cost] : m_starts) {
+        g = std::min(g, cost + m_g[node]);
+        rhs = std::min(rhs, cost + m_rhs[node]);
+    }
+    const float m = std::min(g, rhs);
+    return g == rhs && !(m_open.front().key < Key{ m + m_km, m });
+}
+
+bool DStarLite::ComputePath()
+{
+    if (!m_graph || m_starts.empty()) return false;
+    const Graph& g = *m_graph;
+
+    while (!m_open.empty() && !startsSettled()) {
+        std::ranges::pop_heap(m_open, greaterKey);
+        const auto [oldKey, u] = m_open.back();
+        m_open.pop_back();
+
+        if (m_g[u] == m_rhs[u]) continue; // stale: became consistent after this entry was pushed
+
+        const Key newKey = calcKey(u);
+        if (oldKey < newKey) { push(u); continue; }
+
+        if (m_g[u] > m_rhs[u]) {
+            // Overconsistent: settle and propagate the improvement
+            m_g[u] = m_rhs[u];
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) updateVertex(g.edgeTarget(e));
+        } else {
+            // Underconsistent (a cost went up): invalidate and let neighbours re-derive
+            m_g[u] = kBlockedCost;
+            updateVertex(u);
+            for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) updateVertex(g.edgeTarget(e));
+        }
+    }
+    return PathCost() < kBlockedCost;
+}
+
+float DStarLite::PathCost() const
+{
+    float best = kBlockedCost;
+    for (const auto& [node, cost] : m_starts) best = std::min(best, cost + m_g[node]);
+    return best;
+}
+
+bool DStarLite::ExtractPath(std::vector<int>& outNodes) const
+{
+    outNodes.clear();
+    if (!m_graph || PathCost() == kBlockedCost) return false;
+    const Graph& g = *m_graph;
+
+    int u = -1;
+    float best = kBlockedCost;
+    for (const auto& [node, cost] : m_starts) {
+        if (cost + m_g[node] < best) { best = cost + m_g[node]; u = node; }
+    }
+
+    // Descend g: stop at a goal once leaving it would not be cheaper
+    for (int steps = 0; steps <= g.size(); ++steps) {
+        outNodes.push_back(u);
+        int next = -1;
+        float nextCost = m_goalCost[u];
+        for (int e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+            const float c = g.edgeCost(e) + m_g[g.edgeTarget(e)];
+            if (c < nextCost) { nextCost = c; next = g.edgeTarget(e); }
+        }
+        if (next < 0) return m_goalCost[u] < kBlockedCost;
+        u = next;
+    }
+    return false; // g values inconsistent (should not happen after ComputePath)
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,72 @@
+#pragma once
+
+/// @brief D* Lite search over the nav graph that keeps its state between replans, for repairing paths after edge cost changes.
+
+#include "Pathfinding/Graph/Graph.h"
+#include <vector>
+#include <utility>
+#include <span>
+#include <Play.h>
+
+namespace Pathfinding {
+
+// Searches backwards from a goal set, so the agent's start can move and changed edges only
+// re-expand the nodes whose distance-to-goal actually changed (Koenig & Likhachev).
+// Goals and starts are node sets with entry/exit offsets, which is how points attached to the
+// middle of an edge are expressed. Edge costs are read live from the graph.
+class DStarLite {
+public:
+  // For goals the cost from the node to the goal point, for starts from the start point to the node
+  using Terminal = NodeTerminal;
+
+  // Starts over for a new goal; the next ComputePath is a full search
+  void Init(const Graph& g, std::span<const Terminal> goals);
+  void Clear();
+
+  [[nodiscard]] bool initialised() const { return m_graph != nullptr; }
+
+  // Replaces the goal set (e.g. the goal's edge side got closed); like an edge change,
+  // only nodes whose goal cost differs are re-evaluated
+  void SetGoals(std::span<const Terminal> goals);
+
+  // Sets the start set; startPos is the agent position used by the heuristic
+  void SetStart(const Play::Vector2D& startPos, std::span<const Terminal> starts);
+
+  // Re-evaluates both endpoints of every edge whose cost changed since the last ComputePath
+  void EdgesChanged(std::span<const std::pair<int, int>> edges);
+
+  // Brings the search up to date for the current start set. Returns false if no start reaches a goal.
+  bool ComputePath();
+
+  // Cost and node sequence of the best route from the start set to the goal set (call after ComputePath)
+  [[nodiscard]] float PathCost() const;
+  bool ExtractPath(std::vector<int>& outNodes) const;
+
+private:
+  struct Key {
+    float k1{ 0.0f };
+    float k2{ 0.0f };
+    bool operator<(const Key& o) const { return k1 < o.k1 || (k1 == o.k1 && k2 < o.k2); }
+  };
+  struct OpenRec { Key key; int node; };
+
+  static bool greaterKey(const OpenRec& a, const OpenRec& b) { return b.key < a.key; }
+
+  [[nodiscard]] float h(int n) const;
+  [[nodiscard]] Key calcKey(int n) const;
+  void updateVertex(int n);
+  void push(int n);
+  [[nodiscard]] bool startsSettled() const;
+
+  const Graph* m_graph{ nullptr };
+  std::vector<float> m_g{};
+  std::vector<float> m_rhs{};
+  std::vector<float> m_goalCost{}; // infinity for non-goal nodes
+  std::vector<Terminal> m_goals{};
+  std::vector<OpenRec> m_open{};   // lazy min-heap: stale entries are skipped on pop
+  std::vector<Terminal> m_starts{};
+  Play::Vector2D m_startPos{ 0.0f, 0.0f };
+  float m_km{ 0.0f };              // heuristic offset accumulated as the start moves
+};
+
+} // namespace Pathfinding
@@ -0,0 +1,30 @@
+#pragma once
+
+/// @brief Per-agent state for repairing a followed path after the nav graph changes.
+
+#include "DStarLite.h"
+#include <Play.h>
+#include <cstdint>
+
+namespace Pathfinding {
+
+// Owned by whoever follows the path (one per agent) and passed to PathfinderService::RepairPath.
+// The D* Lite state is built on the first repair and reused by later ones for the same goal.
+struct PathRepairState {
+  Play::Vector2D goal{ 0.0f, 0.0f };
+  std::uint32_t navVersion{ 0 }; // nav version the current path is valid for
+  bool active{ false };
+  DStarLite search{};
+
+  // Call whenever a new path to 'newGoal' starts being followed
+  void Reset(const Play::Vector2D& newGoal, const std::uint32_t version) {
+    goal = newGoal;
+    navVersion = version;
+    active = true;
+    search.Clear();
+  }
+
+  void Clear() { active = false; search.Clear(); }
+};
+
+} // namespace Pathfinding
@@ -2,162 +2,120 @@
 #include "Obstacles/Structures.h"
 #include "Environment/Environment.h"
 #include "AStar/AStar.h"
+#include "AStar/SearchContext.h"
 #include "Graph/GraphBuilder.h"
+#include "Graph/GraphOverlay.h"
 #include "Helper/Geometry.h" // For Geom::dist, Geom::dist2, Geom::cross
+#include "Helper/WorkerPool.h"
+#include "Cache/NavGraphFile.h"
+#include "Cooperative/SpaceTimeSearch.h"
 
-#include <limits>
 #include <algorithm>
+#include <array>
 #include <random>
+#include <cmath>
 
 namespace Pathfinding {
 
 // --- Static Helper Functions ---
 
-// Project point p onto segment a-b.
-// Returns the projected point and writes the clamped parameter t in [0,1] into outT.
-static Play::Vector2D project(const Play::Vector2D& p, const Play::Vector2D& a, const Play::Vector2D& b, float& outT) {
-
-	// Direction vector of segment a->b
-	const float dirX = b.x - a.x;
-	const float dirY = b.y - a.y;
-
-	// Vector from a to point p
-	const float relX = p.x - a.x;
-	const float relY = p.y - a.y;
-
-	// Squared length of segment
-	const float len2 = dirX*dirX + dirY*dirY;
-
-	// Handle degenerate segment: return endpoint a
-	if (len2 <= 1e-6f) {
-		outT = 0.0f;
-		return a; }
-
-	// Projection parameter (not yet clamped)
-	float t = (dirX*relX + dirY*relY) / len2;
-
-	// Clamp to segment
-	if (t < 0.0f) t = 0.0f;
-	else if (t > 1.0f) t = 1.0f;
-
-	outT = t;
-	return Play::Vector2D{ a.x + t*dirX, a.y + t*dirY };
-}
-
-// Enumerate unique undirected edges from graph g.
-// Returns pairs (u,v) with u < v to avoid duplicates.
-static std::vector<std::pair<int,int>> listEdges(const Graph& g) {
-	std::vector<std::pair<int,int>> edges;
-	edges.reserve(g.size() * 3); // heuristic reserve: average degree ~3
-
-	for (int u = 0; u < g.size(); ++u) {
-		for (const auto &[to, cost] : g.nodes()[u].edges) {
-			int v = to;
-			// Only collect each undirected edge once (u < v)
-			if (u < v) edges.emplace_back(u, v);
-		}
-	}
-	return edges;
-}
-
-// Projects an arbitrary world point onto the base graph, returning the world position of the projection.
-static Play::Vector2D ProjectPointToGraph(const Graph& base, const Play::Vector2D& point, const float snapDist)
+// Finds where a point attaches to the base graph without modifying it:
+// the nearest node within snapDist, otherwise the closest point on the nearest edge.
+// Nodes inside a blocker are not snapped to, and a split of a closed edge records which
+// side of the split point the blocker is on.
+static GraphAnchor FindAnchor(const Graph& base, const SpatialIndex& index, const std::vector<Rect>& blockers, const Play::Vector2D& point, const float snapDist)
 {
+    GraphAnchor anchor;
+
     // 1. Try to snap to nearest existing node within snapDist
-    float bestNodeD2 = snapDist * snapDist;
-    for (int i = 0; i < base.size(); ++i) {
-        const auto& q = base.nodes()[i].pos;
-        const float d2 = Geom::dist2(point, q);
-        if (d2 <= bestNodeD2) { return q; } // Snapped to a node, return its position
+    anchor.node = index.NearestNode(base, point, snapDist);
+    if (anchor.node >= 0) {
+        const Play::Vector2D nodePos = base.pos(anchor.node);
+        const bool buried = std::ranges::any_of(blockers, [&](const Rect& r) { return PointInRect(nodePos, r); });
+        if (!buried) {
+            anchor.pos = nodePos;
+            return anchor;
+        }
+        anchor.node = -1;
     }
 
-    // 2. Otherwise find closest edge (by perpendicular distance) and project onto it
-    float bestEdgeD2 = std::numeric_limits<float>::infinity();
-    Play::Vector2D bestProjection = point; // Default to original point if no edge found
-
-    auto edges = listEdges(base);
-    for (auto [a, b] : edges) {
-        const auto& Apos = base.nodes()[a].pos;
-        const auto& Bpos = base.nodes()[b].pos;
-
-        float t;
-        Play::Vector2D projP = project(point, Apos, Bpos, t);
-        const float d2 = Geom::dist2(point, projP);
-
-        if (d2 < bestEdgeD2) {
-            bestEdgeD2 = d2;
-            bestProjection = projP;
+    // 2. Otherwise find closest edge (by perpendicular distance) to split virtually
+    SpatialIndex::EdgeHit hit;
+    if (index.NearestEdge(base, point, hit)) {
+        anchor.a = hit.a;
+        anchor.b = hit.b;
+        anchor.t = hit.t;
+        anchor.pos = hit.pos;
+
+        const int e = base.findEdge(hit.a, hit.b);
+        if (e >= 0 && base.edgeCost(e) == kBlockedCost) {
+            anchor.blockedToA = SegmentHitsAnyRect(hit.pos, base.pos(hit.a), blockers);
+            anchor.blockedToB = SegmentHitsAnyRect(hit.pos, base.pos(hit.b), blockers);
         }
     }
-    return bestProjection;
+    return anchor;
 }
 
-// Attaches a point to an augmented graph, returning the index of the new or snapped node.
-static int AttachPointToGraph(const Graph& base,
-                              Graph& augmented,
-                              const Play::Vector2D& point,
-                              const float snapDist)
+// Graph nodes a path can leave an anchor through, with the length of the stretch to each:
+// a node anchor leaves through itself, an edge anchor through either end of its edge
+// (infinite cost on a side closed by a dynamic obstacle). Returns the number of exits.
+static int AnchorExits(const Graph& g, const GraphAnchor& anchor, std::array<NodeTerminal, 2>& out)
 {
-    // 1. Try to snap to nearest existing node within snapDist
-    int snappedNode = -1;
-    float bestNodeD2 = snapDist * snapDist;
-    for (int i = 0; i < base.size(); ++i) {
-        const auto& q = base.nodes()[i].pos;
-        const float d2 = Geom::dist2(point, q);
-        if (d2 <= bestNodeD2) { bestNodeD2 = d2; snappedNode = i; }
-    }
-    if (snappedNode >= 0) return snappedNode;
-
-    // 2. Otherwise find closest edge (by perpendicular distance) and split it
-    float bestEdgeD2 = std::numeric_limits<float>::infinity();
-    int bestA = -1, bestB = -1;
-    Play::Vector2D bestProjection{};
-
-    auto edges = listEdges(base);
-    for (auto [a, b] : edges) {
-        const auto& Apos = base.nodes()[a].pos;
-        const auto& Bpos = base.nodes()[b].pos;
-
-        float t;
-        Play::Vector2D projP = project(point, Apos, Bpos, t);
-        const float d2 = Geom::dist2(point, projP);
-
-        if (d2 < bestEdgeD2) {
-            bestEdgeD2 = d2;
-            bestA = a;
-            bestB = b;
-            bestProjection = projP;
-        }
-    }
-
-    if (bestA < 0 || bestB < 0) return -1;
-
-    // 3. Insert new node at projection into `augmented` and replace the
-    // undirected edge (bestA,bestB)
-    const int newIdx = augmented.addNode(bestProjection);
+    if (!anchor.onEdge()) { out[0] = { anchor.node, 0.0f }; return 1; }
+    out[0] = { anchor.a, anchor.blockedToA ? kBlockedCost : Geom::dist(anchor.pos, g.pos(anchor.a)) };
+    out[1] = { anchor.b, anchor.blockedToB ? kBlockedCost : Geom::dist(anchor.pos, g.pos(anchor.b)) };
+    return 2;
+}
 
-    // Remove existing edge bestA -> bestB
-    auto& edgesA = augmented.nodes()[bestA].edges;
-    std::erase_if(edgesA, [&](const Edge &e) { return e.to == bestB; });
+// Length of the direct stretch between two anchors on the same edge; infinite if they are on
+// different edges or a dynamic obstacle lies between them (both facing sides closed)
+static float SameEdgeCost(const GraphAnchor& s, const GraphAnchor& g)
+{
+    if (!s.onEdge() || !g.onEdge() || s.a != g.a || s.b != g.b) return kBlockedCost;
+    const bool blocked = (s.t <= g.t) ? (s.blockedToB && g.blockedToA) : (s.blockedToA && g.blockedToB);
+    return blocked ? kBlockedCost : Geom::dist(s.pos, g.pos);
+}
 
-    // Remove existing edge bestB -> bestA
-    auto& edgesB = augmented.nodes()[bestB].edges;
-    std::erase_if(edgesB, [&](const Edge &e) { return e.to == bestA; });
+// Moves the endpoints of a cached polyline onto this query's exact attachment points
+// (the cached entry may come from a nearby point in the same bucket) and fixes up the cost.
+static void RetargetEndpoints(PathResult& result, const GraphAnchor& start, const GraphAnchor& goal)
+{
+    auto& pts = result.polyline;
+    const size_t n = pts.size();
+    if (n < 2) return;
 
-    // Add split edges with accurate geometric costs
-    const float costA = Geom::dist(base.nodes()[bestA].pos, bestProjection);
-    const float costB = Geom::dist(bestProjection, base.nodes()[bestB].pos);
-    augmented.addEdge(bestA, newIdx, costA);
-    augmented.addEdge(newIdx, bestB, costB);
+    if (start.onEdge()) {
+        result.cost += Geom::dist(start.pos, pts[1]) - Geom::dist(pts[0], pts[1]);
+        pts[0] = start.pos;
+    }
+    if (goal.onEdge()) {
+        result.cost += Geom::dist(pts[n - 2], goal.pos) - Geom::dist(pts[n - 2], pts[n - 1]);
+        pts[n - 1] = goal.pos;
+    }
+}
 
-    return newIdx;
+// Per-thread generator for the random point queries
+static std::mt19937& RandomEngine()
+{
+    thread_local std::mt19937 engine{ std::random_device{}() };
+    return engine;
 }
 
 // --- PathfinderService Implementation ---
 
+PathfinderService::PathfinderService() = default;
+PathfinderService::~PathfinderService() = default;
+
 void PathfinderService::SetConfig(const PathfindingConfig& cfg)
 {
     m_config = cfg;
+    m_cache.SetCapacity(cfg.pathCacheCapacity);
+    m_cache.Clear();
+    m_flowFields.Configure(cfg.flowFieldCapacity, cfg.flowFieldTTL, cfg.flowFieldMinStarts);
+    m_danger.SetWeight(CostLayer::Sight, cfg.sightDangerCost);
+    m_danger.SetWeight(CostLayer::Bullets, cfg.bulletDangerCost);
+    m_reservations.Configure(cfg.cooperativeStep);
+    m_cooperativeGoals.clear();
 }
 
 const PathfindingConfig& PathfinderService::GetConfig() const
@@ -167,7 +125,22 @@ const PathfindingConfig& PathfinderService::GetConfig() const
 
 void PathfinderService::Rebuild()
 {
+    std::unique_lock planning(m_planningMutex);
     m_graph.clear();
+    m_index.clear();
+    m_components.clear();
+    m_edgeLengthCdf.clear();
+    m_staticObstacles.clear();
+    m_allPairs.clear();
+    m_clusters.clear();
+    m_cache.Clear();
+    m_flowFields.Clear();
+    m_baseCosts.clear();
+    m_changeLog.clear();
+    m_danger.Reset(0);
+    m_reservations.Clear();
+    m_cooperativeGoals.clear();
+    m_rebuildVersion = ++m_navVersion; // anything planned before is stale
 
     if (Structures.empty())
         return;
@@ -178,76 +151,692 @@ void PathfinderService::Rebuild()
         return; // inset too large; nothing to build
 
     const std::vector<Rect> inflatedObstacles = BuildInflatedObstacles(m_config);
-    BuildCenterlineGraph(playArea, inflatedObstacles, m_graph);
+    m_staticObstacles.Build(inflatedObstacles, INDEX_CELL_SIZE);
+
+    // Warm start: the graph, its components and the index as saved for identical inputs
+    const std::string& cachePath = m_config.navCachePath;
+    const std::uint64_t cacheKey = NavGraphFile::Key(playArea, inflatedObstacles, INDEX_CELL_SIZE);
+    if (cachePath.empty() || !NavGraphFile::Load(cachePath, cacheKey, m_graph, m_components, m_index)) {
+        BuildCenterlineGraph(playArea, inflatedObstacles, m_graph);
+        m_index.Build(m_graph, INDEX_CELL_SIZE);
+        LabelConnectedComponents(m_graph, m_components);
+        if (!cachePath.empty()) NavGraphFile::Save(cachePath, cacheKey, m_graph, m_components, m_index);
+    }
+
+    // Dynamic obstacles outlive rebuilds: re-inflate with the current config and close their edges
+    m_baseCosts.resize(m_graph.edgeCount());
+    for (int e = 0; e < m_graph.edgeCount(); ++e) m_baseCosts[e] = m_graph.edgeCost(e);
+    const float inflate = m_config.tankRadius + m_config.safetyMargin;
+    for (size_t i = 0; i < m_dynamicBounds.size(); ++i) m_dynamicInflated[i] = InflateRect(m_dynamicBounds[i], inflate);
+    SyncDynamicTable();
+    bool anyClosed = false;
+    if (!m_dynamicTable.empty()) {
+        std::vector<Geom::Segment> segments;
+        segments.reserve(m_index.Edges().size());
+        for (const auto& [a, b] : m_index.Edges()) segments.push_back({ m_graph.pos(a), m_graph.pos(b) });
+        std::vector<std::uint8_t> blocked(segments.size());
+        m_dynamicTable.SegmentsHitAny(segments, blocked);
+        for (size_t i = 0; i < blocked.size(); ++i) {
+            if (!blocked[i]) continue;
+            const auto [a, b] = m_index.Edges()[i];
+            m_graph.setEdgeCost(m_graph.findEdge(a, b), kBlockedCost);
+            m_graph.setEdgeCost(m_graph.findEdge(b, a), kBlockedCost);
+            anyClosed = true;
+        }
+    }
+    if (anyClosed) LabelConnectedComponents(m_graph, m_components);
+    m_danger.Reset(m_graph.edgeCount());
+
+    // Running edge lengths for uniform sampling of walkable points
+    m_edgeLengthCdf.resize(m_index.Edges().size());
+    float total = 0.0f;
+    for (size_t i = 0; i < m_index.Edges().size(); ++i) {
+        const auto [a, b] = m_index.Edges()[i];
+        total += Geom::dist(m_graph.pos(a), m_graph.pos(b));
+        m_edgeLengthCdf[i] = total;
+    }
+
+    if (m_config.precomputeAllPairs)
+        m_allPairs.Build(m_graph, m_config.allPairsBudgetBytes); // stays empty if over budget
+    if (m_allPairs.empty() && m_config.hierarchyClusterSize > 0.0f)
+        m_clusters.Build(m_graph, m_config.hierarchyClusterSize);
 }
 
 std::optional<PathResult> PathfinderService::PlanPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos) const
+{
+    SearchContext ctx;
+    return PlanPath(startPos, goalPos, ctx);
+}
+
+std::optional<PathResult> PathfinderService::PlanPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx) const
 {
     PathResult result;
-    if (FindAttachedPath(startPos, goalPos, result)) {
+    if (FindAttachedPath(startPos, goalPos, ctx, result)) {
         return result;
     }
     return std::nullopt;
 }
 
+void PathfinderService::PlanPaths(const std::span<const PathQuery> queries, const std::span<PathResult> outResults) const
+{
+    const size_t count = std::min(queries.size(), outResults.size());
+    const auto planning = LockForPlanning();
+    std::lock_guard lock(m_batchMutex);
+
+    if (count < MIN_PARALLEL_BATCH) {
+        if (m_workerContexts.empty()) m_workerContexts.resize(1);
+        for (size_t i = 0; i < count; ++i)
+            FindAttachedPath(queries[i].start, queries[i].goal, m_workerContexts[0], outResults[i]);
+        return;
+    }
+
+    if (!m_workers) {
+        m_workers = std::make_unique<Threading::WorkerPool>();
+        m_workerContexts.resize(m_workers->Size() + 1);
+    }
+
+    // Queries only read the graph, index and tables; the cache locks internally
+    m_workers->ParallelFor(static_cast<int>(count), [&](const int i, const unsigned slot) {
+        FindAttachedPath(queries[i].start, queries[i].goal, m_workerContexts[slot], outResults[i]);
+    });
+}
+
+GraphAnchor PathfinderService::FindAttachment(const Play::Vector2D& worldPos) const
+{
+    return FindAnchor(m_graph, m_index, m_dynamicInflated, worldPos, SNAP_DISTANCE);
+}
+
 Play::Vector2D PathfinderService::ProjectToWalkable(const Play::Vector2D& worldPos) const
 {
-    return ProjectPointToGraph(m_graph, worldPos, SNAP_DISTANCE);
+    const GraphAnchor anchor = FindAttachment(worldPos);
+    return anchor.valid() ? anchor.pos : worldPos; // no graph: leave the point unchanged
 }
 
 Play::Vector2D PathfinderService::GetRandomReachablePoint() const
 {
-    if (m_graph.size() == 0) {
+    if (m_graph.size() == 0 || m_edgeLengthCdf.empty()) {
         return {0.f, 0.f};
     }
 
-    // Get the playable area boundaries
-    const auto [minx, miny, maxx, maxy] = GetOuterPlayableRect(m_config);
+    // Pick a point uniformly along the total edge length: the edge by binary search over the running
+    // lengths, then the offset on it. Edges closed by dynamic obstacles are re-drawn.
+    std::uniform_real_distribution<float> along(0.0f, m_edgeLengthCdf.back());
+    Play::Vector2D point{};
+    for (int attempt = 0; attempt < MAX_SAMPLE_ATTEMPTS; ++attempt) {
+        const float u = along(RandomEngine());
+        const auto it = std::ranges::upper_bound(m_edgeLengthCdf, u);
+        const auto id = static_cast<int>(std::min<std::ptrdiff_t>(it - m_edgeLengthCdf.begin(), std::ssize(m_edgeLengthCdf) - 1));
+        const auto [a, b] = m_index.Edges()[id];
+        const float before = id > 0 ? m_edgeLengthCdf[id - 1] : 0.0f;
+        const float length = m_edgeLengthCdf[id] - before;
+        const float t = length > 0.0f ? std::clamp((u - before) / length, 0.0f, 1.0f) : 0.0f;
+        const Play::Vector2D pa = m_graph.pos(a), pb = m_graph.pos(b);
+        point = { pa.x + (pb.x - pa.x) * t, pa.y + (pb.y - pa.y) * t };
+        if (m_graph.edgeCost(m_graph.findEdge(a, b)) != kBlockedCost) return point;
+    }
+    return ProjectToWalkable(point);
+}
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+std::optional<Play::Vector2D> PathfinderService::GetRandomReachablePoint(const Play::Vector2D& center, const float radius) const
+{
+    const int component = ComponentAt(center);
+    if (component < 0 || radius <= 0.0f) return std::nullopt;
+
+    // Part [t0, t1] of every open edge near the circle that lies inside it, weighted by its length
+    struct Piece { int a; int b; float t0; float t1; };
+    std::vector<int> candidates;
+    m_index.EdgesInBox(center.x - radius, center.y - radius, center.x + radius, center.y + radius, candidates);
+    std::vector<Piece> pieces;
+    std::vector<float> cdf;
+    const float r2 = radius * radius;
+    for (const int id : candidates) {
+        const auto [a, b] = m_index.Edges()[id];
+        if (m_components[a] != component || m_graph.edgeCost(m_graph.findEdge(a, b)) == kBlockedCost) continue;
+
+        // |pa + t * d - center|^2 = r^2, solved for t and clipped to the segment
+        const Play::Vector2D pa = m_graph.pos(a), pb = m_graph.pos(b);
+        const Play::Vector2D d{ pb.x - pa.x, pb.y - pa.y }, f{ pa.x - center.x, pa.y - center.y };
+        const float A = Geom::dot(d, d), B = 2.0f * Geom::dot(f, d), C = Geom::dot(f, f) - r2;
+        if (A <= 0.0f) continue;
+        const float disc = B * B - 4.0f * A * C;
+        if (disc <= 0.0f) continue;
+        const float root = std::sqrt(disc);
+        const float t0 = std::max(0.0f, (-B - root) / (2.0f * A)), t1 = std::min(1.0f, (-B + root) / (2.0f * A));
+        if (t1 <= t0) continue;
+
+        pieces.push_back({ a, b, t0, t1 });
+        cdf.push_back((cdf.empty() ? 0.0f : cdf.back()) + (t1 - t0) * std::sqrt(A));
+    }
+    if (pieces.empty()) return std::nullopt;
+
+    std::uniform_real_distribution<float> along(0.0f, cdf.back());
+    const auto it = std::ranges::upper_bound(cdf, along(RandomEngine()));
+    const Piece& p = pieces[std::min<size_t>(it - cdf.begin(), pieces.size() - 1)];
+    std::uniform_real_distribution<float> within(p.t0, p.t1);
+    const float t = within(RandomEngine());
+    const Play::Vector2D pa = m_graph.pos(p.a), pb = m_graph.pos(p.b);
+    return Play::Vector2D{ pa.x + (pb.x - pa.x) * t, pa.y + (pb.y - pa.y) * t };
+}
+
+bool PathfinderService::IsReachable(const Play::Vector2D& startPos, const Play::Vector2D& goalPos) const
+{
+    const int startComp = ComponentAt(startPos);
+    return startComp >= 0 && startComp == ComponentAt(goalPos);
+}
 
-    // Generate random coordinates within the playable area
-    std::uniform_real_distribution<float> distX(minx, maxx);
-    std::uniform_real_distribution<float> distY(miny, maxy);
+// --- Dynamic Obstacles ---
 
-    const Play::Vector2D randomPoint = {distX(gen), distY(gen)};
+void PathfinderService::SetDangerSource(const std::uint32_t key, const DangerSource& source)
+{
+    if (m_graph.size() <= 0) return;
+    m_danger.Set(key, source, m_graph, m_index);
+}
 
-    // Project this random point onto the nearest walkable part of the graph
-    return ProjectToWalkable(randomPoint);
+void PathfinderService::RemoveDangerSource(const std::uint32_t key)
+{
+    m_danger.Remove(key);
 }
 
-bool PathfinderService::IsReachable(const Play::Vector2D& startPos, const Play::Vector2D& goalPos) const
+std::optional<PathResult> PathfinderService::PlanTacticalPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, const TacticalQuery& query, SearchContext& ctx) const
+{
+    if (m_graph.size() <= 0) return std::nullopt;
+
+    GraphOverlay overlay(m_graph);
+    const int startIdx = overlay.attach(FindAttachment(startPos));
+    const int goalIdx  = overlay.attach(FindAttachment(goalPos));
+    if (startIdx < 0 || goalIdx < 0) return std::nullopt;
+
+    // The asking tank's own sources are taken back out edge by edge
+    if (query.excludeOwner >= 0) m_danger.OwnerContributions(query.excludeOwner, query.layers, m_dangerExcluded);
+    else m_dangerExcluded.clear();
+
+    std::vector<int>& nodePath = ctx.scratchPath();
+    float pathCost = 0.0f;
+    if (!FindPathTactical(overlay, startIdx, goalIdx, m_danger, query.layers, m_dangerExcluded, ctx, nodePath, &pathCost))
+        return std::nullopt;
+
+    PathResult result;
+    result.polyline.reserve(nodePath.size());
+    for (const int idx : nodePath) result.polyline.push_back(overlay.pos(idx));
+    result.cost = pathCost;
+    return result;
+}
+
+std::optional<PathResult> PathfinderService::PlanCooperativePath(const int agent, const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx)
+{
+    if (m_graph.size() <= 0) return std::nullopt;
+
+    const GraphAnchor start = FindAttachment(startPos);
+    const GraphAnchor goal  = FindAttachment(goalPos);
+    if (!start.valid() || !goal.valid()) return std::nullopt;
+
+    // Without a plan to make room for, the agent's old reservations are void either way
+    m_reservations.Release(agent);
+    if (SameEdgeCost(start, goal) < kBlockedCost) return PlanPath(startPos, goalPos, ctx);
+
+    // The field to the goal is both the heuristic and the path beyond the window
+    const PathCacheEndpoint goalKey = CacheEndpoint(goal, m_config.pathCacheQuantum);
+    CooperativeGoal& target = m_cooperativeGoals[agent];
+    if (!target.field || !(target.goal == goalKey)) {
+        target.goal = goalKey;
+        target.field = BuildFlowField(goal);
+    }
+    const FlowField& field = *target.field;
+
+    const float stepSec = m_reservations.StepSec();
+    SpaceTimeQuery query;
+    query.agent = agent;
+    query.startStep = m_reservations.Now();
+    query.windowSteps = std::max(1, static_cast<int>(std::ceil(m_config.cooperativeWindow / stepSec)));
+    query.stepPx = std::max(1.0f, m_config.cooperativeSpeed * stepSec);
+
+    std::array<NodeTerminal, 2> exits{};
+    const int numStart = AnchorExits(m_graph, start, exits);
+    std::vector<SpaceTimeStep> plan;
+    if (!FindSpaceTimePath(m_graph, m_reservations, field, std::span(exits.data(), numStart), query, plan))
+        return PlanPath(startPos, goalPos, ctx);
+
+    // Scheduled part: departure times relative to now (the current step is partly gone)
+    PathResult result;
+    auto departAt = [&](const std::uint32_t step) {
+        return std::max(0.0f, static_cast<float>(step - query.startStep) * stepSec - m_reservations.Phase());
+    };
+    if (start.onEdge()) {
+        result.polyline.push_back(start.pos);
+        result.departures.push_back(0.0f);
+    }
+    for (const SpaceTimeStep& p : plan) {
+        result.polyline.push_back(m_graph.pos(p.node));
+        result.departures.push_back(departAt(p.depart));
+    }
+
+    // Past the window (or parked at the goal exit): straight down the field
+    for (int n = field.NextHop(plan.back().node); n >= 0; n = field.NextHop(n)) result.polyline.push_back(m_graph.pos(n));
+    if (goal.onEdge()) result.polyline.push_back(goal.pos);
+    for (size_t i = 1; i < result.polyline.size(); ++i) result.cost += Geom::dist(result.polyline[i - 1], result.polyline[i]);
+
+    const bool parked = field.NextHop(plan.back().node) < 0;
+    ReserveSpaceTimePath(m_graph, m_reservations, plan, query, parked);
+    // Stretches off the nodes: onto the graph from an edge start, and the last bit to a parked goal
+    const std::uint32_t windowEnd = query.startStep + static_cast<std::uint32_t>(query.windowSteps);
+    if (start.onEdge()) ReserveEdgeStretch(m_graph, m_reservations, start.a, start.b, query.startStep, plan.front().arrive, agent);
+    if (parked && goal.onEdge()) ReserveEdgeStretch(m_graph, m_reservations, goal.a, goal.b, plan.back().arrive, windowEnd, agent);
+    return result;
+}
+
+PathfinderService::DynamicObstacleId PathfinderService::AddDynamicObstacle(const Rect& bounds)
+{
+    std::unique_lock planning(m_planningMutex);
+    const DynamicObstacleId id = m_nextDynamicId++;
+    m_dynamicIds.push_back(id);
+    m_dynamicBounds.push_back(bounds);
+    m_dynamicInflated.push_back(InflateRect(bounds, m_config.tankRadius + m_config.safetyMargin));
+    RefreshDynamicArea(m_dynamicInflated.back());
+    return id;
+}
+
+bool PathfinderService::MoveDynamicObstacle(const DynamicObstacleId id, const Rect& bounds)
+{
+    std::unique_lock planning(m_planningMutex);
+    const auto it = std::ranges::find(m_dynamicIds, id);
+    if (it == m_dynamicIds.end()) return false;
+    const size_t i = it - m_dynamicIds.begin();
+
+    // Edges under the old footprint may reopen, edges under the new one may close
+    const Rect before = m_dynamicInflated[i];
+    m_dynamicBounds[i] = bounds;
+    m_dynamicInflated[i] = InflateRect(bounds, m_config.tankRadius + m_config.safetyMargin);
+    const Rect& after = m_dynamicInflated[i];
+    RefreshDynamicArea({ std::min(before.minx, after.minx), std::min(before.miny, after.miny),
+                         std::max(before.maxx, after.maxx), std::max(before.maxy, after.maxy) });
+    return true;
+}
+
+bool PathfinderService::RemoveDynamicObstacle(const DynamicObstacleId id)
 {
-    return PlanPath(startPos, goalPos).has_value();
+    std::unique_lock planning(m_planningMutex);
+    const auto it = std::ranges::find(m_dynamicIds, id);
+    if (it == m_dynamicIds.end()) return false;
+    const auto i = it - m_dynamicIds.begin();
+
+    const Rect area = m_dynamicInflated[i];
+    m_dynamicIds.erase(it);
+    m_dynamicBounds.erase(m_dynamicBounds.begin() + i);
+    m_dynamicInflated.erase(m_dynamicInflated.begin() + i);
+    RefreshDynamicArea(area);
+    return true;
+}
+
+// Does any segment of the polyline cross the rect?
+static bool PolylineHitsRect(const std::vector<Play::Vector2D>& polyline, const Rect& rect)
+{
+    for (size_t i = 1; i < polyline.size(); ++i)
+        if (SegmentIntersectsRect(polyline[i - 1], polyline[i], rect)) return true;
+    return false;
+}
+
+PathfinderService::RepairOutcome PathfinderService::RepairPath(PathRepairState& state, const Play::Vector2D& currentPos, const std::vector<Play::Vector2D>& currentPath, PathResult& outResult) const
+{
+    outResult.polyline.clear();
+    outResult.cost = 0.0f;
+    if (!state.active || state.navVersion == m_navVersion) return RepairOutcome::Unchanged;
+
+    // 1. Collect what changed since the path was planned. Closing edges away from the path
+    //    leaves it valid; reopening anywhere may have made a shorter route.
+    Rect area{};
+    std::vector<std::pair<int, int>> edges;
+    bool reopened = false;
+    const bool logged = ChangesSince(state.navVersion, area, edges, reopened);
+    if (logged && state.search.initialised()) state.search.EdgesChanged(edges);
+    if (logged && !reopened && !PolylineHitsRect(currentPath, area)) {
+        state.navVersion = m_navVersion;
+        return RepairOutcome::Unchanged;
+    }
+    state.navVersion = m_navVersion;
+
+    const GraphAnchor start = FindAttachment(currentPos);
+    const GraphAnchor goal = FindAttachment(state.goal);
+    if (!start.valid() || !goal.valid()) return RepairOutcome::NoPath;
+
+    // 2. Fresh search if there is none yet or the log no longer covers the gap.
+    //    The goal's own edge may have been closed on one side, so its exits are refreshed too.
+    std::array<NodeTerminal, 2> exits{};
+    const int numGoal = AnchorExits(m_graph, goal, exits);
+    if (!logged || !state.search.initialised()) state.search.Init(m_graph, std::span(exits.data(), numGoal));
+    else state.search.SetGoals(std::span(exits.data(), numGoal));
+
+    // 3. Bring the search up to date for where the agent is now
+    const int numStart = AnchorExits(m_graph, start, exits);
+    state.search.SetStart(currentPos, std::span(exits.data(), numStart));
+    state.search.ComputePath();
+
+    const float direct = SameEdgeCost(start, goal);
+    const float searched = state.search.PathCost();
+    if (direct < kBlockedCost && direct <= searched) {
+        outResult.polyline = { start.pos, goal.pos };
+        outResult.cost = direct;
+        return RepairOutcome::Repaired;
+    }
+
+    std::vector<int> nodePath;
+    if (searched == kBlockedCost || !state.search.ExtractPath(nodePath)) return RepairOutcome::NoPath;
+
+    outResult.polyline.reserve(nodePath.size() + 2);
+    if (start.onEdge()) outResult.polyline.push_back(start.pos);
+    for (const int idx : nodePath) outResult.polyline.push_back(m_graph.pos(idx));
+    if (goal.onEdge()) outResult.polyline.push_back(goal.pos);
+    outResult.cost = searched;
+    return RepairOutcome::Repaired;
+}
+
+bool PathfinderService::RefineRoute(PendingRoute& route, std::vector<Play::Vector2D>& inOutPolyline, int hops, SearchContext& ctx) const
+{
+    if (route.empty()) return true;
+    if (route.graphVersion != m_rebuildVersion || m_clusters.empty()) return false;
+
+    std::vector<int> nodes;
+    size_t next = 0; // hops before it are refined
+    for (; next + 1 < route.nodes.size() && hops != 0; ++next, --hops) {
+        nodes.clear();
+        if (!m_clusters.RefineHop(m_graph, route.nodes[next], route.nodes[next + 1], ctx, nodes)) return false;
+        for (const int idx : nodes) inOutPolyline.push_back(m_graph.pos(idx));
+    }
+    route.nodes.erase(route.nodes.begin(), route.nodes.begin() + static_cast<std::ptrdiff_t>(next));
+
+    if (route.nodes.size() < 2 && route.goalOffNode) {
+        inOutPolyline.push_back(route.goal);
+        route.clear();
+    }
+    return true;
 }
 
 // --- Private Implementation ---
 
-bool PathfinderService::FindAttachedPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, PathResult& outResult) const
+int PathfinderService::ComponentAt(const Play::Vector2D& pos) const
+{
+    const GraphAnchor anchor = FindAttachment(pos);
+    if (!anchor.valid()) return -1;
+
+    if (!anchor.onEdge()) return m_components[anchor.node];
+
+    // Leave a split edge through a side not closed by a dynamic obstacle
+    if (!anchor.blockedToA) return m_components[anchor.a];
+    if (!anchor.blockedToB) return m_components[anchor.b];
+    return -1;
+}
+
+bool PathfinderService::FindAttachedPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx, PathResult& outResult) const
 {
     outResult.polyline.clear();
     outResult.cost = 0.0f;
+    outResult.route.clear();
 
     if (m_graph.size() <= 0) return false;
 
-    // Work on a cloned augmented graph so we don't modify the original base
-    Graph augmented = m_graph;
+    const GraphAnchor startAnchor = FindAttachment(startPos);
+    const GraphAnchor goalAnchor  = FindAttachment(goalPos);
+    if (!startAnchor.valid() || !goalAnchor.valid()) return false;
+
+    // The all-pairs walk is exact and as cheap as a cache hit, so the cache only fronts A*
+    if (!m_allPairs.empty())
+        return FindTablePath(startAnchor, goalAnchor, ctx, outResult);
+
+    // Goals several agents head to are served from a shared flow field
+    if (m_flowFields.enabled() && FindFieldPath(startAnchor, goalAnchor, outResult))
+        return true;
+
+    // Long queries go through the cluster graph; short ones stay exact (and cached)
+    if (!m_clusters.empty() && Geom::dist(startAnchor.pos, goalAnchor.pos) > m_config.hierarchyClusterSize)
+        return FindHierarchicalPath(startAnchor, goalAnchor, ctx, outResult);
+
+    const float quantum = m_config.pathCacheQuantum;
+    const PathCacheKey key{ CacheEndpoint(startAnchor, quantum), CacheEndpoint(goalAnchor, quantum) };
+    if (m_cache.Lookup(key, outResult.polyline, outResult.cost)) {
+        RetargetEndpoints(outResult, startAnchor, goalAnchor);
+        return true;
+    }
 
-    // Attach both endpoints to the augmented graph
-    const int startIdx = AttachPointToGraph(m_graph, augmented, startPos, SNAP_DISTANCE);
-    const int goalIdx  = AttachPointToGraph(m_graph, augmented, goalPos, SNAP_DISTANCE);
+    const bool found = FindOverlayPath(startAnchor, goalAnchor, ctx, outResult);
+    if (found) m_cache.Insert(key, outResult.polyline, outResult.cost);
+    return found;
+}
+
+PathCacheEndpoint PathfinderService::CacheEndpoint(const GraphAnchor& anchor, const float quantum) const
+{
+    if (!anchor.onEdge()) return { anchor.node, -1, -1, 0 };
+
+    // Bucket by distance along the edge so the quantum is in pixels regardless of edge length
+    const float along = anchor.t * Geom::dist(m_graph.pos(anchor.a), m_graph.pos(anchor.b));
+    return { -1, anchor.a, anchor.b, static_cast<int>(along / std::max(1.0f, quantum)) };
+}
+
+std::shared_ptr<const FlowField> PathfinderService::BuildFlowField(const GraphAnchor& goal) const
+{
+    std::array<NodeTerminal, 2> exits{};
+    const int numGoal = AnchorExits(m_graph, goal, exits);
+    auto field = std::make_shared<FlowField>();
+    field->Build(m_graph, std::span(exits.data(), numGoal));
+    return field;
+}
+
+bool PathfinderService::FindFieldPath(const GraphAnchor& start, const GraphAnchor& goal, PathResult& outResult) const
+{
+    // 1. Count the request; the field exists (or is built) once enough starts shared the goal
+    const PathCacheEndpoint goalKey = CacheEndpoint(goal, m_config.flowFieldQuantum);
+    bool build = false;
+    std::shared_ptr<const FlowField> field = m_flowFields.Request(goalKey, CacheEndpoint(start, m_config.pathCacheQuantum), build);
+    if (!field && build) {
+        field = BuildFlowField(goal);
+        m_flowFields.Insert(goalKey, field);
+    }
+    if (!field) return false;
+
+    // Both points on one edge may connect along it; leave that to the search
+    if (SameEdgeCost(start, goal) < kBlockedCost) return false;
+
+    // 2. Leave the start through the exit closest to the goal
+    std::array<NodeTerminal, 2> exits{};
+    const int numStart = AnchorExits(m_graph, start, exits);
+    int from = -1;
+    float best = kBlockedCost;
+    for (int i = 0; i < numStart; ++i) {
+        const float c = exits[i].cost + field->Distance(exits[i].node);
+        if (c < best) { best = c; from = exits[i].node; }
+    }
+    if (from < 0) return false;
+
+    // 3. The field was built for some goal in this bucket, and its distances end with that goal's last
+    //    stretch. This goal leaves through the same exit nodes with stretches longer by some delta per
+    //    exit (negative if shorter). Swapping the stretch at the exit the walk ends at is exact only when
+    //    that exit has the smallest delta: any other exit then costs at least as much. Otherwise (or if
+    //    the field cannot reach one of this goal's open exits) leave the query to the search.
+    std::array<NodeTerminal, 2> goalExits{};
+    const int numGoal = AnchorExits(m_graph, goal, goalExits);
+    const int to = field->Terminal(from);
+    float minDelta = kBlockedCost, toDelta = kBlockedCost;
+    for (int i = 0; i < numGoal; ++i) {
+        const auto& [node, cost] = goalExits[i];
+        if (!(cost < kBlockedCost)) continue; // closed by a dynamic obstacle
+        const auto fieldGoal = std::ranges::find(field->Goals(), node, &NodeTerminal::node);
+        if (fieldGoal == field->Goals().end() || !(fieldGoal->cost < kBlockedCost)) return false;
+        const float delta = cost - fieldGoal->cost;
+        minDelta = std::min(minDelta, delta);
+        if (node == to) toDelta = delta;
+    }
+    if (!(toDelta < kBlockedCost) || toDelta > minDelta) return false;
+
+    outResult.polyline.clear();
+    if (start.onEdge()) outResult.polyline.push_back(start.pos);
+    for (int n = from; n >= 0; n = field->NextHop(n)) outResult.polyline.push_back(m_graph.pos(n));
+    if (goal.onEdge()) outResult.polyline.push_back(goal.pos);
+
+    outResult.cost = best + toDelta;
+    return true;
+}
+
+bool PathfinderService::FindOverlayPath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const
+{
+    // Splice both endpoints in virtually; the base graph is never copied or modified
+    GraphOverlay overlay(m_graph);
+    const int startIdx = overlay.attach(start);
+    const int goalIdx  = overlay.attach(goal);
     if (startIdx < 0 || goalIdx < 0) return false;
 
-    // Run pathfinding on augmented graph
-    std::vector<int> nodePath;
+    // Run pathfinding on the overlay
+    std::vector<int>& nodePath = ctx.scratchPath();
     float pathCost = 0.0f;
-    if (!FindPath(augmented, startIdx, goalIdx, nodePath, &pathCost)) return false;
+    if (!FindPath(overlay, startIdx, goalIdx, ctx, nodePath, &pathCost)) return false;
 
     // Convert node indices to world-space points
-    for (const int idx : nodePath) outResult.polyline.push_back(augmented.nodes()[idx].pos);
+    outResult.polyline.reserve(nodePath.size());
+    for (const int idx : nodePath) outResult.polyline.push_back(overlay.pos(idx));
     outResult.cost = pathCost;
     return true;
 }
 
+bool PathfinderService::FindHierarchicalPath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const
+{
+    std::array<NodeTerminal, 2> startExits{}, goalExits{};
+    const int numStart = AnchorExits(m_graph, start, startExits);
+    const int numGoal  = AnchorExits(m_graph, goal, goalExits);
+
+    // Transitions are a subset of the border crossings, and dynamic obstacles can close the ones a
+    // region relies on, so a miss falls back to the flat search (which also settles unreachable goals)
+    PendingRoute& route = outResult.route;
+    float routeCost = kBlockedCost;
+    if (!m_clusters.FindRoute(m_graph, std::span(startExits.data(), numStart), std::span(goalExits.data(), numGoal),
+                              goal.pos, ctx, route.nodes, routeCost)) {
+        route.clear();
+        return FindOverlayPath(start, goal, ctx, outResult);
+    }
+
+    // Both points on the same edge: they can connect directly along it
+    const float direct = SameEdgeCost(start, goal);
+    if (direct < kBlockedCost && direct <= routeCost) {
+        route.clear();
+        outResult.polyline = { start.pos, goal.pos };
+        outResult.cost = direct;
+        return true;
+    }
+
+    route.goal = goal.pos;
+    route.goalOffNode = goal.onEdge();
+    route.graphVersion = m_rebuildVersion;
+    if (start.onEdge()) outResult.polyline.push_back(start.pos);
+    outResult.polyline.push_back(m_graph.pos(route.nodes.front()));
+    outResult.cost = routeCost;
+    return RefineRoute(route, outResult.polyline, std::max(1, m_config.hierarchyEagerHops), ctx);
+}
+
+bool PathfinderService::FindTablePath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const
+{
+    std::array<NodeTerminal, 2> startExits{}, goalExits{};
+    const int numStart = AnchorExits(m_graph, start, startExits);
+    const int numGoal  = AnchorExits(m_graph, goal, goalExits);
+
+    // Best combination of exits (at most 2 x 2 table lookups)
+    float bestCost = AllPairsTable::kUnreachable;
+    int bestFrom = -1, bestTo = -1;
+    for (int i = 0; i < numStart; ++i) {
+        for (int j = 0; j < numGoal; ++j) {
+            const float c = startExits[i].cost + m_allPairs.Distance(startExits[i].node, goalExits[j].node) + goalExits[j].cost;
+            if (c < bestCost) { bestCost = c; bestFrom = startExits[i].node; bestTo = goalExits[j].node; }
+        }
+    }
+
+    // Both points on the same edge: they can connect directly along it
+    const float direct = SameEdgeCost(start, goal);
+    if (direct < kBlockedCost && direct <= bestCost) {
+        outResult.polyline = { start.pos, goal.pos };
+        outResult.cost = direct;
+        return true;
+    }
+
+    if (bestFrom < 0) return false; // different components
+
+    std::vector<int>& nodePath = ctx.scratchPath();
+    nodePath.clear();
+    m_allPairs.AppendPath(bestFrom, bestTo, nodePath);
+
+    outResult.polyline.reserve(nodePath.size() + 2);
+    if (start.onEdge()) outResult.polyline.push_back(start.pos);
+    for (const int idx : nodePath) outResult.polyline.push_back(m_graph.pos(idx));
+    if (goal.onEdge()) outResult.polyline.push_back(goal.pos);
+    outResult.cost = bestCost;
+    return true;
+}
+
+void PathfinderService::SyncDynamicTable()
+{
+    std::vector<Geom::Box> boxes;
+    boxes.reserve(m_dynamicInflated.size());
+    for (const auto& [minx, miny, maxx, maxy] : m_dynamicInflated) boxes.push_back({ minx, miny, maxx, maxy });
+    m_dynamicTable.Assign(boxes);
+}
+
+void PathfinderService::RefreshDynamicArea(const Rect& area)
+{
+    if (m_graph.size() == 0) return;
+
+    // Only edges bucketed under the area can have changed; re-test those against every obstacle in one batch
+    SyncDynamicTable();
+    std::vector<int> candidates;
+    m_index.EdgesInBox(area.minx, area.miny, area.maxx, area.maxy, candidates);
+    std::vector<Geom::Segment> segments;
+    segments.reserve(candidates.size());
+    for (const int id : candidates) {
+        const auto [a, b] = m_index.Edges()[id];
+        segments.push_back({ m_graph.pos(a), m_graph.pos(b) });
+    }
+    std::vector<std::uint8_t> hits(candidates.size());
+    m_dynamicTable.SegmentsHitAny(segments, hits);
+
+    NavChange change{ m_navVersion + 1, area, {}, false };
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto [a, b] = m_index.Edges()[candidates[i]];
+        const int ab = m_graph.findEdge(a, b), ba = m_graph.findEdge(b, a);
+        const bool blocked = hits[i] != 0;
+        const float cost = blocked ? kBlockedCost : m_baseCosts[ab];
+        if (m_graph.edgeCost(ab) == cost) continue;
+
+        m_graph.setEdgeCost(ab, cost);
+        m_graph.setEdgeCost(ba, blocked ? kBlockedCost : m_baseCosts[ba]);
+        change.edges.emplace_back(a, b);
+        change.reopened |= !blocked;
+    }
+    if (change.edges.empty()) return;
+
+    m_clusters.UpdateCosts(m_graph, change.edges);
+    m_navVersion = change.version;
+    m_changeLog.push_back(std::move(change));
+    if (m_changeLog.size() > MAX_CHANGE_LOG) m_changeLog.erase(m_changeLog.begin());
+
+    // Everything derived from edge costs is stale
+    LabelConnectedComponents(m_graph, m_components);
+    if (m_config.precomputeAllPairs) m_allPairs.Build(m_graph, m_config.allPairsBudgetBytes);
+    m_cache.Clear();
+    m_flowFields.Clear();
+    m_cooperativeGoals.clear();
+}
+
+bool PathfinderService::ChangesSince(const std::uint32_t sinceVersion, Rect& outArea, std::vector<std::pair<int, int>>& outEdges, bool& outReopened) const
+{
+    outEdges.clear();
+    outReopened = false;
+    if (sinceVersion < m_rebuildVersion) return false;
+    if (sinceVersion >= m_navVersion) return true;
+    if (m_changeLog.empty() || m_changeLog.front().version > sinceVersion + 1) return false;
+
+    bool first = true;
+    for (const NavChange& change : m_changeLog) {
+        if (change.version <= sinceVersion) continue;
+        if (first) { outArea = change.area; first = false; }
+        outArea = { std::min(outArea.minx, change.area.minx), std::min(outArea.miny, change.area.miny),
+                    std::max(outArea.maxx, change.area.maxx), std::max(outArea.maxy, change.area.maxy) };
+        outEdges.insert(outEdges.end(), change.edges.begin(), change.edges.end());
+        outReopened |= change.reopened;
+    }
+    return true;
+}
+
 } // namespace Pathfinding
\ No newline at end of file
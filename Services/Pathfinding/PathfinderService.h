@@ -3,22 +3,64 @@
 /// @brief Builds a simple nav graph and serves path queries (plan/project/reachability) for the tank arena.
 
 #include "Graph/Graph.h"
+#include "Graph/SpatialIndex.h"
+#include "Graph/GraphOverlay.h"
+#include "AllPairs/AllPairsTable.h"
+#include "Cache/PathCache.h"
+#include "FlowField/FlowFieldCache.h"
+#include "Incremental/PathRepair.h"
+#include "Hierarchy/ClusterGraph.h"
+#include "Hierarchy/PendingRoute.h"
+#include "Tactical/CostLayers.h"
+#include "Cooperative/ReservationTable.h"
+#include "Environment/Environment.h"
+#include "Helper/BoxTable.h"
 #include "Types.h"
 #include <Play.h>
 #include <vector>
 #include <optional>
+#include <span>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+namespace Threading { class WorkerPool; }
 
 namespace Pathfinding {
 
+class SearchContext;
+
 // A struct to hold the result of a path query, including the path itself and its total cost.
+// With hierarchical planning the polyline may stop short of the goal; 'route' then holds the rest
+// (see RefineRoute) and 'cost' is still the cost of the whole path.
 struct PathResult {
     std::vector<Play::Vector2D> polyline;
     float cost{};
+    PendingRoute route{};
+    // Cooperative plans only: seconds from planning time before which polyline[i] may not be left
+    // (waits for other agents). Covers the points inside the planning window; empty otherwise.
+    std::vector<float> departures{};
+};
+
+// Options of a tactical query: which danger layers to avoid and whose sources to ignore.
+struct TacticalQuery {
+    std::uint32_t layers{ LayerBit(CostLayer::Sight) | LayerBit(CostLayer::Bullets) };
+    int excludeOwner{ -1 }; // typically the asking tank (its own view cone is no danger to it)
+};
+
+// One entry of a batched planning request.
+struct PathQuery {
+    Play::Vector2D start{ 0.0f, 0.0f };
+    Play::Vector2D goal{ 0.0f, 0.0f };
 };
 
 class PathfinderService {
 public:
-    PathfinderService() = default;
+    PathfinderService();
+    ~PathfinderService();
 
     // --- Configuration & Setup ---
 
@@ -38,27 +80,212 @@ public:
     // This is the primary function for movement planning.
     [[nodiscard]] std::optional<PathResult> PlanPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos) const;
 
+    // Same as above, reusing a caller-owned search context (no per-query scratch allocations).
+    [[nodiscard]] std::optional<PathResult> PlanPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx) const;
+
+    // Plans a whole batch across the worker pool, each worker with its own search context.
+    // outResults[i] receives the path for queries[i]; an empty polyline means no path was found.
+    // Both spans must have the same size.
+    void PlanPaths(std::span<const PathQuery> queries, std::span<PathResult> outResults) const;
+
+    // Appends up to 'hops' abstract hops of a hierarchical route (all of them if hops < 0) to the
+    // polyline it belongs to, and the goal once the route is used up. False if the route was planned
+    // on a graph since rebuilt or a hop became impassable; the caller should replan to route.goal.
+    bool RefineRoute(PendingRoute& route, std::vector<Play::Vector2D>& inOutPolyline, int hops, SearchContext& ctx) const;
+
+    // Where a point attaches to the nav graph (node or point on an edge); invalid if there is no graph.
+    // Two points with the same attachment node/edge get paths that differ only in their last point.
+    [[nodiscard]] GraphAnchor FindAttachment(const Play::Vector2D& worldPos) const;
+
     // Projects an arbitrary point to the nearest valid "walkable" location on the nav graph.
     [[nodiscard]] Play::Vector2D ProjectToWalkable(const Play::Vector2D& worldPos) const;
 
-    // Returns a random, valid, reachable point on the map.
+    // Returns a random, valid, reachable point on the map: uniform over the length of the open graph
+    // edges (O(log E) through the edge-length CDF built at Rebuild).
     [[nodiscard]] Play::Vector2D GetRandomReachablePoint() const;
-    // TODO: Add version with area constraints or radius around point
 
-    // Checks if a path exists between two points. Cheaper than planning the full path.
+    // Same, restricted to graph edges within 'radius' of 'center' and reachable from it (uniform over
+    // the edge length inside the circle; only edges bucketed near the circle are looked at).
+    // nullopt if no open edge reachable from the center passes through the circle.
+    [[nodiscard]] std::optional<Play::Vector2D> GetRandomReachablePoint(const Play::Vector2D& center, float radius) const;
+
+    // Checks if a path exists between two points. Compares connected-component labels of the
+    // points' graph attachments, so no search is run.
     [[nodiscard]] bool IsReachable(const Play::Vector2D& startPos, const Play::Vector2D& goalPos) const;
 
+    // --- Shared Goals ---
+
+    // Ages the shared flow fields and drops expired ones; call once per frame.
+    void DecayFlowFields(float dt) { m_flowFields.Decay(dt); }
+
+    // --- Tactical Planning ---
+
+    // Danger sources (enemy view cones, bullet corridors) feeding the cost layers. Set moves or adds
+    // the source under 'key'; only the edges under its old and new areas are re-evaluated, and not
+    // even those if it barely moved. Sources are dropped on Rebuild.
+    void SetDangerSource(std::uint32_t key, const DangerSource& source);
+    void RemoveDangerSource(std::uint32_t key);
+
+    // Plans like PlanPath but pays the configured danger cost for every px exposed to the selected
+    // layers, so the path trades length for cover. Always an exact overlay search (no table, cache,
+    // flow field or hierarchy); the returned cost includes the danger costs.
+    // Danger updates and tactical queries belong to the main thread.
+    [[nodiscard]] std::optional<PathResult> PlanTacticalPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, const TacticalQuery& query, SearchContext& ctx) const;
+
+    // --- Cooperative Planning ---
+
+    [[nodiscard]] bool CooperativeEnabled() const { return m_config.cooperativeWindow > 0.0f; }
+
+    // Plans for 'agent' around the reservations of the agents that planned before it, then reserves
+    // the plan for the next config.cooperativeWindow seconds (replacing the agent's previous one), so
+    // agents sharing a corridor are sequenced by waits instead of meeting in it. Agents should replan
+    // about every half window. Falls back to PlanPath (reserving nothing) when the space-time search
+    // fails. Main thread only, like the reservations below.
+    [[nodiscard]] std::optional<PathResult> PlanCooperativePath(int agent, const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx);
+
+    // Frees the agent's reservations (it stopped, died or changed its mind)
+    void ReleaseReservations(const int agent) { m_reservations.Release(agent); }
+
+    // Moves the reservation clock; call once per frame.
+    void AdvanceReservations(const float dt) { m_reservations.Advance(dt); }
+
+    // Held (shared) by planning that runs off the caller's thread: PlanPaths batches and AsyncPlanner
+    // requests. Rebuild and the dynamic-obstacle changes take it exclusively, so they wait for jobs in
+    // flight to finish and jobs started later plan on the updated graph.
+    [[nodiscard]] std::shared_lock<std::shared_mutex> LockForPlanning() const { return std::shared_lock(m_planningMutex); }
+
+    // --- Dynamic Obstacles ---
+
+    // Runtime obstacles (wrecks, barricades...) as raw world rects, inflated like the static structures.
+    // The graph topology stays as built: edges crossing an obstacle are closed and reopened when it
+    // goes away, and only edges bucketed under the changed area are re-tested.
+    // Each change waits for planning jobs in flight on other threads (see LockForPlanning).
+    using DynamicObstacleId = int;
+    DynamicObstacleId AddDynamicObstacle(const Rect& bounds);
+    bool MoveDynamicObstacle(DynamicObstacleId id, const Rect& bounds);
+    bool RemoveDynamicObstacle(DynamicObstacleId id);
+
+    // Inflated static obstacles (structures but the outer wall) with their broadphase grid, built by
+    // Rebuild; for clearance tests such as BuildMotionPrimitives' arc check
+    [[nodiscard]] const ObstacleSet& GetStaticObstacles() const { return m_staticObstacles; }
+
+    // Inflated rects of the current dynamic obstacles (for debug drawing)
+    [[nodiscard]] const std::vector<Rect>& GetDynamicObstacles() const { return m_dynamicInflated; }
+
+    // Bumped by Rebuild and by every dynamic-obstacle change.
+    [[nodiscard]] std::uint32_t GetNavVersion() const { return m_navVersion; }
+
+    // Incremental replanning for an agent following 'currentPath' (from PlanPath) towards state.goal.
+    // Unchanged if the graph did not change since state.navVersion or the changes do not touch the
+    // path; otherwise the path from currentPos is repaired with D* Lite, reusing the search state
+    // kept in 'state' across repairs.
+    enum class RepairOutcome { Unchanged, Repaired, NoPath };
+    RepairOutcome RepairPath(PathRepairState& state, const Play::Vector2D& currentPos, const std::vector<Play::Vector2D>& currentPath, PathResult& outResult) const;
+
+    // --- Diagnostics ---
+
+    // Hit/miss counters of the path cache (cleared on Rebuild/SetConfig, counters are not).
+    [[nodiscard]] PathCache::Stats GetPathCacheStats() const { return m_cache.GetStats(); }
+    void ResetPathCacheStats() { m_cache.ResetStats(); }
+    [[nodiscard]] FlowFieldCache::Stats GetFlowFieldStats() const { return m_flowFields.GetStats(); }
+
 private:
     // --- Internal Implementation ---
 
+    // Component id of the graph location a point attaches to, or -1 if it cannot attach.
+    [[nodiscard]] int ComponentAt(const Play::Vector2D& pos) const;
+
     // Finds a path using temporary graph attachments. The core of PlanPath.
-    bool FindAttachedPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, PathResult& outResult) const;
+    bool FindAttachedPath(const Play::Vector2D& startPos, const Play::Vector2D& goalPos, SearchContext& ctx, PathResult& outResult) const;
+
+    // Cache key part for one attachment point, bucketed every 'quantum' px along an edge.
+    [[nodiscard]] PathCacheEndpoint CacheEndpoint(const GraphAnchor& anchor, float quantum) const;
+
+    // Path walked off the shared flow field of the goal's bucket, with the exact A* cost. False if the
+    // goal has no field (yet) or the field cannot prove the walk shortest for this pair; the caller
+    // then searches.
+    bool FindFieldPath(const GraphAnchor& start, const GraphAnchor& goal, PathResult& outResult) const;
+
+    [[nodiscard]] std::shared_ptr<const FlowField> BuildFlowField(const GraphAnchor& goal) const;
+
+    // A* over the base graph with both anchors spliced in virtually.
+    bool FindOverlayPath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const;
+
+    // Route through the cluster graph, refined for the first config.hierarchyEagerHops hops. Requires !m_clusters.empty().
+    bool FindHierarchicalPath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const;
+
+    // Same result as the overlay search, read from the all-pairs tables. Requires !m_allPairs.empty().
+    bool FindTablePath(const GraphAnchor& start, const GraphAnchor& goal, SearchContext& ctx, PathResult& outResult) const;
+
+    // Re-tests edges under 'area' against the dynamic obstacles and logs the ones that changed.
+    void RefreshDynamicArea(const Rect& area);
+    // Copies m_dynamicInflated into m_dynamicTable
+    void SyncDynamicTable();
+
+    // Union of the changed areas and the changed edges after 'sinceVersion'; outReopened is set if
+    // any of them opened an edge. False if the log does not reach back that far (or the graph was rebuilt since).
+    bool ChangesSince(std::uint32_t sinceVersion, Rect& outArea, std::vector<std::pair<int, int>>& outEdges, bool& outReopened) const;
 
     PathfindingConfig m_config{};
     Graph m_graph{};
+    SpatialIndex m_index{}; // nodes/edges bucketed for snapping, rebuilt with the graph
+    std::vector<int> m_components{}; // connected-component label per node, rebuilt with the graph
+    std::vector<float> m_edgeLengthCdf{}; // running length over m_index.Edges(), for uniform sampling
+    ObstacleSet m_staticObstacles{};
+    AllPairsTable m_allPairs{}; // optional distance/next-hop tables (config.precomputeAllPairs)
+    mutable PathCache m_cache{}; // recently planned paths, cleared whenever the graph changes
+    mutable FlowFieldCache m_flowFields{}; // fields for goals shared by several queries, cleared with the cache
+    ClusterGraph m_clusters{}; // optional abstraction for long queries (config.hierarchyClusterSize)
+    CostLayers m_danger{}; // per-edge danger costs for tactical queries, reset with the graph
+    mutable std::unordered_map<int, float> m_dangerExcluded{}; // scratch: the excluded owner's contributions
+
+    // Cooperative planning: reservations of all agents and each agent's field to its current goal
+    // (the search heuristic, reused while the agent keeps replanning towards the same goal)
+    struct CooperativeGoal {
+        PathCacheEndpoint goal{};
+        std::shared_ptr<const FlowField> field{};
+    };
+    ReservationTable m_reservations{};
+    std::unordered_map<int, CooperativeGoal> m_cooperativeGoals{};
+
+    // Dynamic obstacles and the log of edge changes they caused
+    struct NavChange {
+        std::uint32_t version{ 0 };
+        Rect area{};
+        std::vector<std::pair<int, int>> edges{}; // undirected (u < v)
+        bool reopened{ false };                   // some edge became passable again
+    };
+    std::vector<DynamicObstacleId> m_dynamicIds{};
+    std::vector<Rect> m_dynamicBounds{};          // raw rects, parallel to m_dynamicIds
+    std::vector<Rect> m_dynamicInflated{};        // inflated by tankRadius + safetyMargin
+    Geom::BoxTable m_dynamicTable{};              // m_dynamicInflated in SoA form for batched edge tests
+    DynamicObstacleId m_nextDynamicId{ 1 };
+    std::vector<float> m_baseCosts{};            // edge costs as built, restored when an edge reopens
+    std::vector<NavChange> m_changeLog{};
+    std::uint32_t m_navVersion{ 0 };
+    std::uint32_t m_rebuildVersion{ 0 };
+
+    // Batched planning: worker threads are started on the first batch large enough to share.
+    // One search context per pool slot (caller + workers).
+    mutable std::shared_mutex m_planningMutex; // see LockForPlanning
+    mutable std::mutex m_batchMutex;
+    mutable std::unique_ptr<Threading::WorkerPool> m_workers;
+    mutable std::vector<SearchContext> m_workerContexts;
 
     // Snap distance used for attaching points to the graph.
     static constexpr float SNAP_DISTANCE = 24.0f;
+
+    // Cell size (px) of the snapping index grid.
+    static constexpr float INDEX_CELL_SIZE = 64.0f;
+
+    // Batches smaller than this are planned on the calling thread.
+    static constexpr size_t MIN_PARALLEL_BATCH = 4;
+
+    // Sampling retries when the picked edge is closed by a dynamic obstacle
+    static constexpr int MAX_SAMPLE_ATTEMPTS = 16;
+
+    // Oldest entries of the nav change log are dropped beyond this; agents that fell further behind replan fully.
+    static constexpr size_t MAX_CHANGE_LOG = 64;
 };
 
 } // namespace Pathfinding
\ No newline at end of file
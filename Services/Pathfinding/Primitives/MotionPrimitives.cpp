@@ -35,8 +35,8 @@ static void simplifyPolyline(const std::vector<Play::Vector2D>& in, std::vector<
 }
 
 // Verify that an arc does not intersect obstacles and stays in playable area.
-// TODO: is this function needed?
-static bool arcClearanceOK(const ArcPrim& arc, const std::vector<Rect>& inflated, const PathfindingConfig& params)
+// The arc is walked as a chain of short chords, each tested through the obstacle grid.
+static bool arcClearanceOK(const ArcPrim& arc, const ObstacleSet& obstacles, const PathfindingConfig& params)
 {
 	constexpr int samples = 24; // number of samples along the arc to check
 	const Play::Vector2D ra{ arc.a.x - arc.center.x, arc.a.y - arc.center.y };
@@ -47,7 +47,8 @@ static bool arcClearanceOK(const ArcPrim& arc, const std::vector<Rect>& inflated
         const float angleBetween = std::acos(Geom::clampf((ra.x * rb.x + ra.y * rb.y) / (Geom::len(ra) * Geom::len(rb)), -1.0f, 1.0f));
         const float sweepAng = (arc.cw ? -1.0f : 1.0f) * angleBetween;
 
-	// Sample points along the circular arc and test each point for validity
+	// Sample points along the circular arc and test each point and the chord to it for validity
+	Play::Vector2D prev = arc.a;
 	for (int i = 0; i <= samples; ++i) {
 		const float t = static_cast<float>(i) / samples;
 		const float ang = startAng + sweepAng * t;
@@ -57,7 +58,8 @@ static bool arcClearanceOK(const ArcPrim& arc, const std::vector<Rect>& inflated
 		if (!PointInOuterPlayable(p, params)) return false;
 
 		// Must not intersect any inflated obstacle
-		for (const auto& r : inflated) if (PointInRect(p, r)) return false;
+		if (obstacles.SegmentHitsAny(prev, p)) return false;
+		prev = p;
 	}
 
 	return true;
@@ -81,16 +83,13 @@ static bool intersectLines(const Play::Vector2D& P, const Play::Vector2D& u,cons
 // - params: environment and playability parameters
 // - out: resulting primitives
 // - stats: optional statistics accumulator
-bool BuildMotionPrimitives(const std::vector<Play::Vector2D>& polyline, const float R,const PathfindingConfig& params,MotionPrimitives& out,MotionStats* stats)
+bool BuildMotionPrimitives(const std::vector<Play::Vector2D>& polyline, const float R,const PathfindingConfig& params,MotionPrimitives& out,MotionStats* stats,const ObstacleSet* obstacles)
 {
 	out.straights.clear();
 	out.arcs.clear();
 	if (stats) *stats = {};
 	if (polyline.size() < 2) return false;
 
-	// Precompute inflated obstacles for clearance tests
-	std::vector<Rect> inflated = BuildInflatedObstacles(params);
-
 	// Simplify the input polyline to remove redundant collinear vertices
 	std::vector<Play::Vector2D> pts;
 	simplifyPolyline(polyline, pts);
@@ -159,6 +158,11 @@ bool BuildMotionPrimitives(const std::vector<Play::Vector2D>& polyline, const fl
 				arc.startAngle = Geom::angOf(Play::Vector2D{ T1.x - C.x, T1.y - C.y });
 				arc.endAngle   = Geom::angOf(Play::Vector2D{ T2.x - C.x, T2.y - C.y });
 
+				if (obstacles && !arcClearanceOK(arc, *obstacles, params)) {
+					if (stats) stats->primsRejectedClearance++;
+					continue;
+				}
+
 				cuts[i].ok = true;
 				cuts[i].T1 = T1;
 				cuts[i].T2 = T2;
@@ -8,6 +8,7 @@
 namespace Pathfinding {
 
 struct PathfindingConfig;
+class ObstacleSet;
 
 // Basic motion primitive pieces
 
@@ -41,12 +42,15 @@ struct MotionStats {
 };
 
 // Build motion primitives from a polyline using a target radius R.
-// - Uses conservative clearance against inflated obstacles defined by Params.
+// - Arcs must keep their tangent points inside the playable area of Params.
+// - With 'obstacles' (PathfinderService::GetStaticObstacles()), arcs that would cut through an
+//   inflated obstacle are rejected too and the corner is kept sharp.
 // Returns true if primitives were built
 bool BuildMotionPrimitives(const std::vector<Play::Vector2D>& polyline,
                            float R,
                            const PathfindingConfig& params,
                            MotionPrimitives& out,
-                           MotionStats* stats = nullptr);
+                           MotionStats* stats = nullptr,
+                           const ObstacleSet* obstacles = nullptr);
 
 } // namespace Pathfinding
@@ -0,0 +1,114 @@
+#include "CostLayers.h"
+#include "Pathfinding/Graph/Graph.h"
+#include "Pathfinding/Graph/SpatialIndex.h"
+#include "Helper/Geometry.h"
+#include "Helper/LineOfSight.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Pathfinding {
+
+// Is the point inside the source's area (and visible from its origin)?
+static bool Covers(const DangerSource& s, const Play::Vector2D& p)
+{
+    const Play::Vector2D d{ p.x - s.origin.x, p.y - s.origin.y };
+    const float along = Geom::dot(d, s.dir);
+    if (s.shape == DangerSource::Shape::Cone) {
+        const float dist = Geom::len(d);
+        if (dist > s.range) return false;
+        if (dist > 1e-3f && along < dist * std::cos(s.halfAngle)) return false;
+    } else {
+        if (along < 0.0f || along > s.range || std::abs(Geom::cross(s.dir, d)) > s.halfWidth) return false;
+    }
+    return LOSHelper::HasLOS_RawStructures(s.origin, p);
+}
+
+// Box containing everything the source can cover
+static void Bounds(const DangerSource& s, float& minx, float& miny, float& maxx, float& maxy)
+{
+    if (s.shape == DangerSource::Shape::Cone) {
+        minx = s.origin.x - s.range; maxx = s.origin.x + s.range;
+        miny = s.origin.y - s.range; maxy = s.origin.y + s.range;
+        return;
+    }
+    const Play::Vector2D end{ s.origin.x + s.dir.x * s.range, s.origin.y + s.dir.y * s.range };
+    minx = std::min(s.origin.x, end.x) - s.halfWidth; maxx = std::max(s.origin.x, end.x) + s.halfWidth;
+    miny = std::min(s.origin.y, end.y) - s.halfWidth; maxy = std::max(s.origin.y, end.y) + s.halfWidth;
+}
+
+static bool SameArea(const DangerSource& a, const DangerSource& b, const float moveTolerance, const float turnToleranceCos)
+{
+    return a.layer == b.layer && a.shape == b.shape && a.owner == b.owner && a.range == b.range &&
+           a.halfAngle == b.halfAngle && a.halfWidth == b.halfWidth &&
+           Geom::dist(a.origin, b.origin) <= moveTolerance && Geom::dot(a.dir, b.dir) >= turnToleranceCos;
+}
+
+void CostLayers::Reset(const int edgeCount)
+{
+    for (auto& layer : m_extra) layer.assign(edgeCount, 0.0f);
+    m_sources.clear();
+}
+
+bool CostLayers::Set(const std::uint32_t key, const DangerSource& source, const Graph& g, const SpatialIndex& index)
+{
+    auto [it, inserted] = m_sources.try_emplace(key);
+    Entry& entry = it->second;
+    if (!inserted) {
+        if (SameArea(entry.source, source, kMoveTolerance, kTurnToleranceCos)) return false;
+        Apply(entry, -1.0f); // take the old area out
+    }
+    entry.source = source;
+    entry.added.clear();
+
+    // Re-test only the edges bucketed under the new area
+    const float weight = m_weights[static_cast<int>(source.layer)];
+    if (weight <= 0.0f || source.range <= 0.0f) return true;
+    float minx, miny, maxx, maxy;
+    Bounds(source, minx, miny, maxx, maxy);
+    std::vector<int> candidates;
+    index.EdgesInBox(minx, miny, maxx, maxy, candidates);
+
+    for (const int id : candidates) {
+        const auto [a, b] = index.Edges()[id];
+        const Play::Vector2D pa = g.pos(a), pb = g.pos(b);
+        const float length = Geom::dist(pa, pb);
+        const int samples = std::clamp(static_cast<int>(std::ceil(length / kSampleSpacing)), 1, kMaxSamples);
+        int inside = 0;
+        for (int i = 0; i < samples; ++i) {
+            const float t = (static_cast<float>(i) + 0.5f) / static_cast<float>(samples);
+            inside += Covers(source, { pa.x + (pb.x - pa.x) * t, pa.y + (pb.y - pa.y) * t });
+        }
+        if (inside == 0) continue;
+
+        const float cost = weight * length * static_cast<float>(inside) / static_cast<float>(samples);
+        entry.added.emplace_back(g.findEdge(a, b), cost);
+        entry.added.emplace_back(g.findEdge(b, a), cost);
+    }
+    Apply(entry, 1.0f);
+    return true;
+}
+
+void CostLayers::Remove(const std::uint32_t key)
+{
+    const auto it = m_sources.find(key);
+    if (it == m_sources.end()) return;
+    Apply(it->second, -1.0f);
+    m_sources.erase(it);
+}
+
+void CostLayers::Apply(Entry& entry, const float sign)
+{
+    std::vector<float>& layer = m_extra[static_cast<int>(entry.source.layer)];
+    for (const auto& [e, cost] : entry.added) layer[e] += sign * cost;
+}
+
+void CostLayers::OwnerContributions(const int owner, const std::uint32_t layerMask, std::unordered_map<int, float>& out) const
+{
+    out.clear();
+    for (const auto& [key, entry] : m_sources) {
+        if (entry.source.owner != owner || !(layerMask & LayerBit(entry.source.layer))) continue;
+        for (const auto& [e, cost] : entry.added) out[e] += cost;
+    }
+}
+
+} // namespace Pathfinding
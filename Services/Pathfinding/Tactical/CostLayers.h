@@ -0,0 +1,85 @@
+#pragma once
+
+/// @brief Additive per-edge danger costs (enemy sight cones, bullet corridors) kept alongside the nav graph.
+
+#include <Play.h>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <utility>
+
+namespace Pathfinding {
+
+class Graph;
+class SpatialIndex;
+
+enum class CostLayer : std::uint8_t { Sight, Bullets, Count };
+inline constexpr int kCostLayerCount = static_cast<int>(CostLayer::Count);
+inline constexpr std::uint32_t LayerBit(const CostLayer layer) { return 1u << static_cast<int>(layer); }
+
+// Area one source makes dangerous: a view cone (origin, facing, range, half angle) or a corridor
+// (segment from origin along dir for 'range', 'halfWidth' either side). Structures block both.
+struct DangerSource {
+  enum class Shape : std::uint8_t { Cone, Corridor };
+
+  CostLayer layer{ CostLayer::Sight };
+  Shape shape{ Shape::Cone };
+  int owner{ -1 };                   // tank the source belongs to (queries can exclude their own)
+  Play::Vector2D origin{ 0.0f, 0.0f };
+  Play::Vector2D dir{ 1.0f, 0.0f };  // unit
+  float range{ 0.0f };
+  float halfAngle{ 0.0f };           // radians, cones
+  float halfWidth{ 0.0f };           // px, corridors
+};
+
+// Each layer holds one extra cost per directed edge: the sum over its sources of
+// weight * (edge length) * (fraction of the edge inside the source's area). Sources remember what
+// they added, so moving one only re-tests the edges under its old and new areas; sources that moved
+// less than the tolerances below are left alone. Edge ids must stay stable (true across dynamic
+// obstacle changes; Reset after a rebuild).
+class CostLayers {
+public:
+  // Sizes the layers for the graph and drops every source
+  void Reset(int edgeCount);
+  void SetWeight(CostLayer layer, float costPerPx) { m_weights[static_cast<int>(layer)] = costPerPx; }
+
+  // Adds or moves a source. Returns true if edge costs were re-evaluated.
+  bool Set(std::uint32_t key, const DangerSource& source, const Graph& g, const SpatialIndex& index);
+  void Remove(std::uint32_t key);
+  [[nodiscard]] bool Has(const std::uint32_t key) const { return m_sources.contains(key); }
+
+  [[nodiscard]] bool empty() const { return m_sources.empty(); }
+
+  // Extra cost of directed edge e summed over the layers in 'layerMask'
+  [[nodiscard]] float Extra(const int e, const std::uint32_t layerMask) const {
+    float sum = 0.0f;
+    for (int l = 0; l < kCostLayerCount; ++l)
+      if (layerMask & (1u << l)) sum += m_extra[l][e];
+    return sum > 0.0f ? sum : 0.0f; // add/remove round-off
+  }
+
+  // What the sources of 'owner' in the masked layers add per directed edge
+  void OwnerContributions(int owner, std::uint32_t layerMask, std::unordered_map<int, float>& out) const;
+
+private:
+  struct Entry {
+    DangerSource source{};
+    std::vector<std::pair<int, float>> added{}; // (directed edge, cost) currently in the layer
+  };
+
+  void Apply(Entry& entry, float sign);
+
+  // Moves below these keep a source's current contribution
+  static constexpr float kMoveTolerance = 8.0f;      // px
+  static constexpr float kTurnToleranceCos = 0.999f; // ~2.5 degrees
+  // Edges are tested at points this far apart (at most kMaxSamples per edge)
+  static constexpr float kSampleSpacing = 24.0f;
+  static constexpr int kMaxSamples = 16;
+
+  std::array<std::vector<float>, kCostLayerCount> m_extra{};
+  std::array<float, kCostLayerCount> m_weights{};
+  std::unordered_map<std::uint32_t, Entry> m_sources{};
+};
+
+} // namespace Pathfinding
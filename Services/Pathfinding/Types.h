@@ -3,6 +3,8 @@
 /// @brief Configuration types for the pathfinding system.
 
 #include <Play.h>
+#include <cstddef>
+#include <string>
 
 namespace Pathfinding {
 
@@ -25,6 +27,51 @@ struct PathfindingConfig {
 
   // Desired turning radius for motion primitives (px). Affects corner primitives
   float turnRadius{40.0f};
+
+  // Precompute all-pairs distances/next hops at Rebuild so PlanPath is a table walk instead of a search.
+  // Only used while the tables fit in allPairsBudgetBytes (8 bytes per node pair); otherwise A* is used.
+  bool precomputeAllPairs{false};
+  size_t allPairsBudgetBytes{8u * 1024u * 1024u};
+
+  // Max paths kept in the LRU path cache (0 disables it). Points attaching within pathCacheQuantum
+  // px of each other along the same edge share an entry. Unused while all-pairs tables are built.
+  size_t pathCacheCapacity{128};
+  float pathCacheQuantum{16.0f};
+
+  // Binary nav graph file (graph, components, spatial index) loaded by Rebuild when it was written for
+  // the same structures and config, and rewritten otherwise. Empty disables it.
+  std::string navCachePath{};
+
+  // Hierarchical planning: nodes are grouped into square clusters of this size (px) and queries whose
+  // ends lie in different clusters search between cluster entrances first. The first
+  // hierarchyEagerHops abstract hops are refined into waypoints up front, the rest is left in
+  // PathResult::route for the caller to refine as it advances. 0 disables it; unused while all-pairs
+  // tables are built.
+  float hierarchyClusterSize{0.0f};
+  int hierarchyEagerHops{4};
+
+  // Flow fields for goals several agents head to (a chase or search converging on one point). Once
+  // flowFieldMinStarts different start points asked for the same goal within flowFieldTTL seconds,
+  // a reverse Dijkstra field is built for it and later paths there are walked off the field instead
+  // of searched. Goals within flowFieldQuantum px along the same edge share a field; at most
+  // flowFieldCapacity fields are kept. 0 TTL disables it; unused while all-pairs tables are built.
+  float flowFieldTTL{0.0f};
+  int flowFieldMinStarts{2};
+  float flowFieldQuantum{48.0f};
+  size_t flowFieldCapacity{4};
+
+  // Tactical (cautious) planning: extra cost per px of path inside an enemy's view cone or a bullet's
+  // corridor, on top of the distance. Only PlanTacticalPath uses them.
+  float sightDangerCost{2.0f};
+  float bulletDangerCost{4.0f};
+
+  // Cooperative planning (windowed cooperative A*): agents plan one after the other around each
+  // other's reservations for the next cooperativeWindow seconds, cut into cooperativeStep slices,
+  // assuming they drive at cooperativeSpeed px/s; beyond the window paths ignore other agents.
+  // 0 window disables it.
+  float cooperativeWindow{0.0f};
+  float cooperativeStep{0.25f};
+  float cooperativeSpeed{120.0f};
 };
 
 } // namespace Pathfinding
\ No newline at end of file
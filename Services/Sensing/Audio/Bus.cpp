@@ -4,25 +4,88 @@
 
 namespace Sensing::Audio {
 
+Bus::Bus(const std::size_t capacity, const float ttlSec)
+  : nodes_(std::max<std::size_t>(capacity, 1)), ttlSec_(ttlSec) {
+  heads_.fill(-1);
+  tails_.fill(-1);
+}
+
 void Bus::Push(const BusEvent& eIn) {
-  BusEvent e = eIn;
-  e.seq = ++seqCounter_;
-  q_.push_back(e);
+  if (Size() == nodes_.size()) PopOldest_(); // full: drop the oldest
+
+  const std::uint32_t seq = ++seqCounter_;
+  const int slot = static_cast<int>(seq % nodes_.size());
+  Node& node = nodes_[slot];
+  node.ev = eIn;
+  node.ev.seq = seq;
+  node.ev.timeSec = now_;
+  const int level = LevelFor(eIn.radius);
+  node.bucket = level < kLevels ? BucketOf(level, CellOf(eIn.pos.x, level), CellOf(eIn.pos.y, level)) : kOverflowBucket;
+  node.next = -1;
+
+  if (tails_[node.bucket] >= 0) nodes_[tails_[node.bucket]].next = slot;
+  else heads_[node.bucket] = slot;
+  tails_[node.bucket] = slot;
 }
 
-void Bus::Decay(const float dt, const float ttlSec) {
-  for (auto &e : q_) e.ageSec += dt;
-  std::erase_if(q_, [&](const BusEvent& e){ return e.ageSec > ttlSec; });
+void Bus::Advance(const float dt) {
+  now_ += dt;
+  while (Size() > 0 && !Alive_(nodes_[oldestSeq_ % nodes_.size()].ev)) PopOldest_();
 }
 
-std::vector<BusEvent> Bus::QueryInRadius(const Play::Vector2D& listenerPos) const {
-  std::vector<BusEvent> out;
-  for (const auto &e : q_) {
-    const float dx = e.pos.x - listenerPos.x;
-    const float dy = e.pos.y - listenerPos.y;
-    if (dx*dx + dy*dy <= e.radius * e.radius) out.push_back(e);
+std::size_t Bus::QueryInRadius(const Play::Vector2D& listenerPos, const std::span<BusEvent> out) const {
+  std::size_t count = 0;
+  ForEachAudible(listenerPos, [&](const BusEvent& e) {
+    if (count < out.size()) out[count++] = e;
+  });
+  return count;
+}
+
+int Bus::LevelFor(const float radius) {
+  float cell = kBaseCell;
+  for (int level = 0; level < kLevels; ++level, cell *= 2.0f) {
+    if (radius <= cell) return level;
   }
-  return out;
+  return kLevels;
+}
+
+int Bus::CellOf(const float v, const int level) {
+  return static_cast<int>(std::floor(v / (kBaseCell * static_cast<float>(1 << level))));
+}
+
+int Bus::BucketOf(const int level, const int cx, const int cy) {
+  const std::uint32_t h = static_cast<std::uint32_t>(cx) * 73856093u ^ static_cast<std::uint32_t>(cy) * 19349663u;
+  return level * kBucketsPerLevel + static_cast<int>(h & (kBucketsPerLevel - 1));
+}
+
+int Bus::CollectChains_(const Play::Vector2D& p, std::array<int, kMaxChains>& outHeads) const {
+  // An event's radius fits its level's cell, so a listener it reaches is at most one cell away
+  std::array<int, kMaxChains> buckets;
+  int n = 0;
+  auto add = [&](const int bucket) {
+    if (heads_[bucket] < 0) return;
+    for (int i = 0; i < n; ++i) {
+      if (buckets[i] == bucket) return; // neighbouring cells hashed together
+    }
+    buckets[n] = bucket;
+    outHeads[n++] = heads_[bucket];
+  };
+  for (int level = 0; level < kLevels; ++level) {
+    const int cx = CellOf(p.x, level), cy = CellOf(p.y, level);
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) add(BucketOf(level, cx + dx, cy + dy));
+    }
+  }
+  add(kOverflowBucket);
+  return n;
+}
+
+void Bus::PopOldest_() {
+  Node& node = nodes_[oldestSeq_ % nodes_.size()];
+  heads_[node.bucket] = node.next;
+  if (node.next < 0) tails_[node.bucket] = -1;
+  node.bucket = -1;
+  ++oldestSeq_;
 }
 
 } // namespace Sensing::Audio
@@ -1,8 +1,11 @@
 #pragma once
 
-/// @brief A simple audio event bus for AI hearing simulation.
+/// @brief Audio event bus for AI hearing: a fixed ring of timestamped events, spatially hashed for queries.
 
 #include <vector>
+#include <array>
+#include <span>
+#include <cstddef>
 #include <cstdint>
 #include <Play.h>
 #include "AI/Data/AIEvents.h"
@@ -14,22 +17,101 @@ struct BusEvent {
   Play::Vector2D            pos{};
   float                     radius{0.f};
   AI::SoundHeardEvent::Kind kind{AI::SoundHeardEvent::Kind::None};
-  float                     ageSec{0.f};
-  std::uint32_t             seq{0}; // unique sequence id assigned by Bus on push
+  float                     timeSec{0.f}; // bus time of emission, assigned by Bus on push
+  std::uint32_t             seq{0};       // unique sequence id assigned by Bus on push
 };
 
+// Events live in a fixed-capacity ring (the oldest is dropped when full) until they are older than the
+// TTL; advancing time only pops the expired tail. Each event is hashed into one cell of the level whose
+// cell size covers its radius, so a listener visits just the 3x3 cells around it on every level.
+// Queries allocate nothing and visit events in emission (seq) order; visitors must not Push.
 class Bus {
 public:
+  static constexpr std::size_t kDefaultCapacity = 512;
+  static constexpr float       kDefaultTtlSec = 1.5f;
+
+  explicit Bus(std::size_t capacity = kDefaultCapacity, float ttlSec = kDefaultTtlSec);
+
   void Push(const BusEvent& e);
-  void Decay(float dt, float ttlSec = 1.5f);
-  [[nodiscard]] std::vector<BusEvent> QueryInRadius(const Play::Vector2D& listenerPos) const;
+  // Moves bus time forward and drops events older than the TTL
+  void Advance(float dt);
+
+  [[nodiscard]] float Now() const { return now_; }
+  [[nodiscard]] float AgeOf(const BusEvent& e) const { return now_ - e.timeSec; }
+  [[nodiscard]] std::size_t Size() const { return seqCounter_ + 1 - oldestSeq_; }
 
-  // Debug-only: return a snapshot of all current events (for overlays)
-  [[nodiscard]] std::vector<BusEvent> Debug_All() const { return q_; }
+  // fn(const BusEvent&) for every live event whose radius reaches the listener
+  template <typename Fn>
+  void ForEachAudible(const Play::Vector2D& listenerPos, Fn&& fn) const;
+
+  // Same events copied into out (as many as fit); returns how many were written
+  std::size_t QueryInRadius(const Play::Vector2D& listenerPos, std::span<BusEvent> out) const;
+
+  // fn(const BusEvent&) for every live event, oldest first (overlays)
+  template <typename Fn>
+  void ForEach(Fn&& fn) const;
 
 private:
-  std::vector<BusEvent> q_{};
-  std::uint32_t seqCounter_{0};
+  static constexpr int   kLevels = 6;
+  static constexpr float kBaseCell = 64.0f;        // level L cells are kBaseCell << L wide
+  static constexpr int   kBucketsPerLevel = 64;    // power of two
+  static constexpr int   kOverflowBucket = kLevels * kBucketsPerLevel; // radii beyond the top level
+  static constexpr int   kBucketCount = kOverflowBucket + 1;
+  static constexpr int   kMaxChains = kLevels * 9 + 1;
+
+  // Ring slot; slots of a bucket are chained in push order, so the globally oldest is a chain head
+  struct Node {
+    BusEvent ev{};
+    int      bucket{-1};
+    int      next{-1};
+  };
+
+  [[nodiscard]] static int LevelFor(float radius);
+  [[nodiscard]] static int CellOf(float v, int level);
+  [[nodiscard]] static int BucketOf(int level, int cx, int cy);
+
+  // Heads of the non-empty chains a listener at p can hear from; returns their count
+  int CollectChains_(const Play::Vector2D& p, std::array<int, kMaxChains>& outHeads) const;
+  [[nodiscard]] bool Alive_(const BusEvent& e) const { return now_ - e.timeSec <= ttlSec_; }
+  void PopOldest_();
+
+  std::vector<Node> nodes_{};     // event with sequence s sits at s % capacity
+  std::array<int, kBucketCount> heads_{};
+  std::array<int, kBucketCount> tails_{};
+  float ttlSec_ = kDefaultTtlSec;
+  float now_ = 0.f;
+  std::uint32_t seqCounter_{0};   // last assigned
+  std::uint32_t oldestSeq_{1};    // oldest live
 };
 
+template <typename Fn>
+void Bus::ForEachAudible(const Play::Vector2D& listenerPos, Fn&& fn) const {
+  std::array<int, kMaxChains> cursors;
+  int n = CollectChains_(listenerPos, cursors);
+  while (n > 0) {
+    // Merge the chains by taking the oldest head each step
+    int best = 0;
+    for (int i = 1; i < n; ++i) {
+      if (nodes_[cursors[i]].ev.seq < nodes_[cursors[best]].ev.seq) best = i;
+    }
+    const Node& node = nodes_[cursors[best]];
+    if (node.next >= 0) cursors[best] = node.next;
+    else cursors[best] = cursors[--n];
+
+    const BusEvent& e = node.ev;
+    if (!Alive_(e)) continue;
+    const float dx = e.pos.x - listenerPos.x;
+    const float dy = e.pos.y - listenerPos.y;
+    if (dx*dx + dy*dy <= e.radius * e.radius) fn(e);
+  }
+}
+
+template <typename Fn>
+void Bus::ForEach(Fn&& fn) const {
+  for (std::uint32_t s = oldestSeq_; s <= seqCounter_; ++s) {
+    const BusEvent& e = nodes_[s % nodes_.size()].ev;
+    if (Alive_(e)) fn(e);
+  }
+}
+
 } // namespace Sensing::Audio
@@ -3,51 +3,46 @@
 
 namespace Sensing::Memory {
 
-void Store::RememberSeen(const std::uint32_t id, const Play::Vector2D& pos)  {
-  seen_[id]  = Entry{pos, 0.f, MemorySource::Vision, 0.f};
+Store::Slot& Store::SlotFor_(const std::uint32_t id) {
+  if (id >= slots_.size()) slots_.resize(static_cast<std::size_t>(id) + 1);
+  return slots_[id];
 }
 
-void Store::RememberHeard(const std::uint32_t id, const Play::Vector2D& pos, const float uncertaintyRadius) {
-  heard_[id] = Entry{pos, 0.f, MemorySource::Hearing, uncertaintyRadius};
+void Store::RememberSeen(const std::uint32_t id, const Play::Vector2D& pos, const double now)  {
+  SlotFor_(id).seen  = Entry{pos, now, MemorySource::Vision, 0.f, true};
+}
+
+void Store::RememberHeard(const std::uint32_t id, const Play::Vector2D& pos, const float uncertaintyRadius, const double now) {
+  SlotFor_(id).heard = Entry{pos, now, MemorySource::Hearing, uncertaintyRadius, true};
 }
 
 void Store::Forget(const std::uint32_t id) {
-  seen_.erase(id);
-  heard_.erase(id);
+  if (id < slots_.size()) slots_[id] = Slot{};
 }
 
-std::optional<LastKnownInfo> Store::LastKnown(std::uint32_t id) const {
-  const auto itSeen  = seen_.find(id);
-  const auto itHeard = heard_.find(id);
+std::optional<LastKnownInfo> Store::LastKnown(const std::uint32_t id, const double now, const float ttlSec) const {
+  if (id >= slots_.size()) return std::nullopt;
+  const auto& [seen, heard] = slots_[id];
 
-  if (itSeen == seen_.end() && itHeard == heard_.end()) return std::nullopt;
-  if (itSeen != seen_.end() && itHeard == heard_.end()) {
-    return LastKnownInfo{ id, itSeen->second.pos, itSeen->second.ageSec, itSeen->second.source, itSeen->second.uncertaintyRadius };
-  }
-  if (itHeard != heard_.end() && itSeen == seen_.end()) {
-    return LastKnownInfo{ id, itHeard->second.pos, itHeard->second.ageSec, itHeard->second.source, itHeard->second.uncertaintyRadius };
-  }
-  // Both present: select the fresher (smaller ageSec)
-  const Entry& se = itSeen->second;
-  const Entry& he = itHeard->second;
-  if (se.ageSec <= he.ageSec) {
-    return LastKnownInfo{ id, se.pos, se.ageSec, se.source, se.uncertaintyRadius };
-  } else {
-    return LastKnownInfo{ id, he.pos, he.ageSec, he.source, he.uncertaintyRadius };
+  // Expired entries read as absent
+  const auto seenAge  = static_cast<float>(now - seen.lastUpdateTime);
+  const auto heardAge = static_cast<float>(now - heard.lastUpdateTime);
+  const bool hasSeen  = seen.present  && seenAge  <= ttlSec;
+  const bool hasHeard = heard.present && heardAge <= ttlSec;
+
+  if (!hasSeen && !hasHeard) return std::nullopt;
+  // Both present: select the fresher (smaller age)
+  if (hasSeen && (!hasHeard || seenAge <= heardAge)) {
+    return LastKnownInfo{ id, seen.pos, seenAge, seen.source, seen.uncertaintyRadius };
   }
+  return LastKnownInfo{ id, heard.pos, heardAge, heard.source, heard.uncertaintyRadius };
 }
 
-void Store::Decay(float dt, float ttlSec) {
-  auto decayMap = [&](auto& m){
-    for (auto& [id, e] : m) e.ageSec += dt;
-    for (auto it = m.begin(); it != m.end(); ) {
-      const bool expired = it->second.ageSec > ttlSec;
-      if (expired) it = m.erase(it);
-      else ++it;
-    }
-  };
-  decayMap(seen_);
-  decayMap(heard_);
+void Store::LastKnownAll(const double now, const float ttlSec, std::vector<LastKnownInfo>& out) const {
+  out.clear();
+  for (std::uint32_t id = 0; id < slots_.size(); ++id) {
+    if (auto info = LastKnown(id, now, ttlSec)) out.push_back(*info);
+  }
 }
 
 } // namespace Sensing::Memory
@@ -1,8 +1,8 @@
 #pragma once
 
-/// @brief A simple store for last known positions of entities seen or heard by the AI.
+/// @brief A store for last known positions of entities seen or heard by the AI, indexed by id.
 
-#include <unordered_map>
+#include <vector>
 #include <optional>
 #include <cstdint>
 #include <Play.h>
@@ -13,22 +13,36 @@ namespace Sensing::Memory {
 
 struct Entry {
   Play::Vector2D pos{};
-  float          ageSec = 0.f;
+  double         lastUpdateTime = 0.0; // sensing clock when remembered
   MemorySource   source{MemorySource::Vision};
   float          uncertaintyRadius{0.f};
+  bool           present = false;
 };
 
+// Tank ids are small dense integers, so entries sit in a flat array indexed by id. Nothing ages per
+// frame: callers pass the current time, ages are derived on read and entries older than the TTL read
+// as absent (and are overwritten by the next sighting).
 class Store {
 public:
-  void RememberSeen (std::uint32_t id, const Play::Vector2D& pos);
-  void RememberHeard(std::uint32_t id, const Play::Vector2D& pos, float uncertaintyRadius);
+  void RememberSeen (std::uint32_t id, const Play::Vector2D& pos, double now);
+  void RememberHeard(std::uint32_t id, const Play::Vector2D& pos, float uncertaintyRadius, double now);
   void Forget(std::uint32_t id);
-  std::optional<LastKnownInfo> LastKnown(std::uint32_t id) const;
-  void Decay(float dt, float ttlSec);
+
+  // Fresher of the live seen/heard entries (vision on ties)
+  [[nodiscard]] std::optional<LastKnownInfo> LastKnown(std::uint32_t id, double now, float ttlSec) const;
+
+  // Every id's LastKnown, in id order (overlays)
+  void LastKnownAll(double now, float ttlSec, std::vector<LastKnownInfo>& out) const;
 
 private:
-  std::unordered_map<std::uint32_t, Entry> seen_;
-  std::unordered_map<std::uint32_t, Entry> heard_;
+  struct Slot {
+    Entry seen{};
+    Entry heard{};
+  };
+
+  Slot& SlotFor_(std::uint32_t id);
+
+  std::vector<Slot> slots_{};
 };
 
 } // namespace Sensing::Memory
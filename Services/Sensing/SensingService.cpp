@@ -1,6 +1,7 @@
 #include "Services/Sensing/SensingService.h"
 #include "Services/Sensing/Vision/FOV.h"
 #include "Services/Sensing/Vision/LOS.h"
+#include "Services/Sensing/Vision/VisibilityMatrix.h"
 #include "Services/Sensing/Memory/Store.h"
 #include "Data/AIContext.h"
 
@@ -21,10 +22,9 @@ void SensingService::SetConfig(const SenseConfig& cfg) {
 const SenseConfig& SensingService::GetConfig() const { return cfg_; }
 
 void SensingService::Update(const float dt, const AI::SelfState& self) {
+    // Memory is timestamped against this clock; nothing there ages per frame
     timeAccum_ += dt;
     self_ = self;
-    // Decay memory
-    store_->Decay(dt, cfg_.memoryTTL);
 }
 
 PerceptionSnapshot SensingService::VisibleNow(const std::vector<AI::Contact>& candidates) const {
@@ -40,17 +40,36 @@ PerceptionSnapshot SensingService::VisibleNow(const std::vector<AI::Contact>& ca
     return snap;
 }
 
+void SensingService::SetFrameVisibility(const Vision::VisibilityMatrix* matrix, const int row) {
+    frameVisibility_ = matrix;
+    frameRow_ = row;
+    frameRemembered_ = false;
+}
+
+PerceptionSnapshot SensingService::VisibleNow() const {
+    PerceptionSnapshot snap;
+    if (!frameVisibility_) return snap;
+
+    frameVisibility_->VisibleTo(frameRow_, snap.visible);
+    // Same memory update as the candidate version, once per frame
+    if (!frameRemembered_) {
+        for (const auto& c : snap.visible) RememberSeen(c.id, c.pos);
+        frameRemembered_ = true;
+    }
+    return snap;
+}
+
 bool SensingService::HasLOS(const Play::Vector2D& a, const Play::Vector2D& b) {
     return Vision::LOS::HasLineOfSight(a, b);
 }
 
 void SensingService::RegisterSound(const std::uint32_t sourceId, const Play::Vector2D& pos, const float radius) const {
-	store_->RememberHeard(sourceId, pos, radius);
+	store_->RememberHeard(sourceId, pos, radius, timeAccum_);
 }
 
 void SensingService::RememberSeen(const std::uint32_t id, const Play::Vector2D& pos) const
 {
-    store_->RememberSeen(id, pos);
+    store_->RememberSeen(id, pos, timeAccum_);
 }
 
 void SensingService::ForgetTarget(const std::uint32_t id) const
@@ -61,14 +80,18 @@ void SensingService::ForgetTarget(const std::uint32_t id) const
 
 
 std::optional<AI::Contact> SensingService::LastKnown(const std::uint32_t id) const {
-    if (const auto info = store_->LastKnown(id)) {
+    if (const auto info = store_->LastKnown(id, timeAccum_, cfg_.memoryTTL)) {
         AI::Contact c{}; c.id = info->id; c.pos = info->pos; return c;
     }
     return std::nullopt;
 }
 
 std::optional<LastKnownInfo> SensingService::Debug_LastKnownInfo(const std::uint32_t id) const {
-    return store_->LastKnown(id);
+    return store_->LastKnown(id, timeAccum_, cfg_.memoryTTL);
+}
+
+void SensingService::Debug_LastKnownAll(std::vector<LastKnownInfo>& out) const {
+    store_->LastKnownAll(timeAccum_, cfg_.memoryTTL, out);
 }
 
 } // namespace Sensing
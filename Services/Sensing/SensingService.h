@@ -13,7 +13,7 @@ namespace AI { struct SelfState; struct Contact; }
 
 namespace Sensing {
 
-namespace Vision { class FOV; class LOS; }
+namespace Vision { class FOV; class LOS; class VisibilityMatrix; }
 namespace Memory { class Store; }
 
 class SensingService {
@@ -30,6 +30,12 @@ public:
   // Vision queries
   [[nodiscard]] PerceptionSnapshot VisibleNow(const std::vector<AI::Contact>& candidates) const;
 
+  // This frame's row of the shared visibility matrix (set by the AI subsystem before sensing runs;
+  // nullptr unbinds). While bound, VisibleNow() reads it instead of testing FOV/LOS again.
+  void SetFrameVisibility(const Vision::VisibilityMatrix* matrix, int row);
+  [[nodiscard]] bool HasFrameVisibility() const { return frameVisibility_ != nullptr; }
+  [[nodiscard]] PerceptionSnapshot VisibleNow() const;
+
   // LOS utility
   static bool HasLOS(const Play::Vector2D& a, const Play::Vector2D& b);
 
@@ -44,15 +50,22 @@ public:
 
   // Debug helper: richer last-known info (source, age, uncertainty)
   [[nodiscard]] std::optional<LastKnownInfo> Debug_LastKnownInfo(std::uint32_t id) const;
+  // Debug helper: every remembered, unexpired target in one pass (overlays)
+  void Debug_LastKnownAll(std::vector<LastKnownInfo>& out) const;
 
 private:
   SenseConfig    cfg_{};
-  float          timeAccum_ = 0.f;
+  double         timeAccum_ = 0.0; // sensing clock, also the memory timestamps
   AI::SelfState  self_{};       // copied each Update, avoidnig dangling pointer risk
   // Modules (owned)
   std::unique_ptr<Vision::FOV>   fov_{};
   std::unique_ptr<Vision::LOS>   los_{};
   std::unique_ptr<Memory::Store> store_{};
+
+  // Shared per-frame visibility (not owned)
+  const Vision::VisibilityMatrix* frameVisibility_ = nullptr;
+  int            frameRow_ = -1;
+  mutable bool   frameRemembered_ = false; // this frame's sightings are already in memory
 };
 
 } // namespace Sensing
@@ -16,6 +16,17 @@ struct SenseConfig {
   float memoryTTL     = 5.0f;
 };
 
+// One observer's view of one target: distance, cone and LOS results (LOS only tested in range and cone)
+struct Sighting {
+  float dist     = 0.f;
+  float cosAngle = -1.f; // between the observer's forward and the direction to the target
+  bool  inRange  = false;
+  bool  inCone   = false;
+  bool  los      = false;
+
+  [[nodiscard]] bool visible() const { return inRange && inCone && los; }
+};
+
 struct PerceptionSnapshot {
   std::vector<AI::Contact> visible;
 };
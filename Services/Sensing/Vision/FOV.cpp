@@ -16,6 +16,31 @@ static inline Play::Vector2D Normalize(const Play::Vector2D& v) {
   return { v.x * inv, v.y * inv };
 }
 
+FOV::Cone FOV::MakeCone(const AI::SelfState& self, const SenseConfig& cfg) {
+  Cone cone;
+  cone.pos = self.pos;
+  cone.maxDist2 = cfg.viewDistance * cfg.viewDistance;
+  const float halfFovRad = (cfg.fovDeg * 0.5f) * (3.14159265358979323846f / 180.0f);
+  cone.cosHalfFov = std::cos(halfFovRad);
+
+  // Forward from rotation (assuming rot is radians; if degrees, convert here)
+  cone.fwd = { std::cos(self.rot), std::sin(self.rot) };
+  return cone;
+}
+
+Sighting FOV::Test(const Cone& cone, const Play::Vector2D& target) {
+  Sighting s;
+  const Play::Vector2D to = { target.x - cone.pos.x, target.y - cone.pos.y };
+  const float d2 = Len2(to);
+  s.dist = std::sqrt(d2);
+  s.inRange = d2 <= cone.maxDist2;
+  if (!s.inRange) return s; // distance cull
+
+  s.cosAngle = Dot(Normalize(to), cone.fwd);
+  s.inCone = s.cosAngle >= cone.cosHalfFov;
+  return s;
+}
+
 void FOV::Compute(const AI::SelfState& self,
                   const std::vector<AI::Contact>& candidates,
                   const LOS& /*los*/,
@@ -23,21 +48,9 @@ void FOV::Compute(const AI::SelfState& self,
                   std::vector<AI::Contact>& outVisible) {
   outVisible.clear();
 
-  const float maxDist2 = cfg.viewDistance * cfg.viewDistance;
-  const float halfFovRad = (cfg.fovDeg * 0.5f) * (3.14159265358979323846f / 180.0f);
-  const float cosHalfFov = std::cos(halfFovRad);
-
-  // Forward from rotation (assuming rot is radians; if degrees, convert here)
-  const Play::Vector2D fwd{ std::cos(self.rot), std::sin(self.rot) };
-
+  const Cone cone = MakeCone(self, cfg);
   for (const auto& c : candidates) {
-    const Play::Vector2D to = { c.pos.x - self.pos.x, c.pos.y - self.pos.y };
-    const float d2 = Len2(to);
-    if (d2 > maxDist2) continue; // distance cull
-
-    const Play::Vector2D dir = Normalize(to);
-    const float dot = Dot(dir, fwd);
-    if (dot < cosHalfFov) continue; // cone cull
+    if (!Test(cone, c.pos).inCone) continue; // distance & cone cull
 
     // LOS check (call static helper)
     if (!LOS::HasLineOfSight(self.pos, c.pos)) continue;
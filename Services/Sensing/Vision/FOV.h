@@ -12,6 +12,19 @@ class LOS;
 
 class FOV {
 public:
+  // View cone of an observer, derived once and tested against many targets
+  struct Cone {
+    Play::Vector2D pos{};
+    Play::Vector2D fwd{};
+    float maxDist2{0.f};
+    float cosHalfFov{1.f};
+  };
+
+  static Cone MakeCone(const AI::SelfState& self, const SenseConfig& cfg);
+
+  // Distance and cone culls for one target (leaves the LOS result unset)
+  static Sighting Test(const Cone& cone, const Play::Vector2D& target);
+
   // Populate outVisible with candidates in cone & LOS
   static void Compute(const AI::SelfState& self,
                const std::vector<AI::Contact>& candidates,
@@ -7,4 +7,8 @@ bool LOS::HasLineOfSight(const Play::Vector2D& a, const Play::Vector2D& b) {
   return LOSHelper::HasLOS_RawStructures(a, b);
 }
 
+void LOS::HasLineOfSight(const std::span<const Geom::Segment> segments, const std::span<std::uint8_t> outClear) {
+  LOSHelper::HasLOS_RawStructures(segments, outClear);
+}
+
 } // namespace Sensing::Vision
@@ -2,7 +2,10 @@
 
 /// @brief Line of Sight (LOS) utility functions for vision sensing.
 
+#include "Helper/BoxTable.h"
 #include <Play.h>
+#include <span>
+#include <cstdint>
 
 namespace Sensing::Vision {
 
@@ -10,6 +13,9 @@ class LOS {
 public:
   // Returns true if the segment a->b does not intersect any world obstacle rectangles.
   static bool HasLineOfSight(const Play::Vector2D& a, const Play::Vector2D& b);
+
+  // Batched form: outClear[i] = HasLineOfSight(segments[i].a, segments[i].b)
+  static void HasLineOfSight(std::span<const Geom::Segment> segments, std::span<std::uint8_t> outClear);
 };
 
 } // namespace Sensing::Vision
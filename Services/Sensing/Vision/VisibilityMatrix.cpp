@@ -0,0 +1,78 @@
+#include "Services/Sensing/Vision/VisibilityMatrix.h"
+#include "Services/Sensing/Vision/FOV.h"
+#include "Services/Sensing/Vision/LOS.h"
+#include "Data/AIContext.h"
+#include <algorithm>
+#include <bit>
+
+namespace Sensing::Vision {
+
+void VisibilityMatrix::Build(const std::vector<Observer>& observers, const std::vector<AI::Contact>& targets) {
+  targets_ = targets;
+  observers_ = static_cast<int>(observers.size());
+  const int T = static_cast<int>(targets_.size());
+  words_ = (T + 63) / 64;
+
+  sightings_.assign(static_cast<size_t>(observers_) * T, Sighting{});
+  bits_.assign(static_cast<size_t>(observers_) * words_, 0u);
+  pairQuery_.assign(static_cast<size_t>(T) * T, -1);
+  sightingQuery_.assign(sightings_.size(), -1);
+  losSegments_.clear();
+
+  // Range and cone first; whatever survives queues its LOS test
+  for (int o = 0; o < observers_; ++o) {
+    const auto& [self, cfg] = observers[o];
+    const FOV::Cone cone = FOV::MakeCone(self, cfg);
+
+    // The observer's own column (absent while it is dead); its LOS results are shared with the targets'
+    const auto own = std::ranges::find(targets_, self.id, &AI::Contact::id);
+    const int column = own != targets_.end() ? static_cast<int>(own - targets_.begin()) : -1;
+
+    for (int t = 0; t < T; ++t) {
+      if (targets_[t].id == self.id) continue; // never sees itself
+      const size_t k = static_cast<size_t>(o) * T + t;
+      Sighting& s = sightings_[k];
+      s = FOV::Test(cone, targets_[t].pos);
+      if (!s.inCone) continue;
+      sightingQuery_[k] = column >= 0 ? QueuePairLOS_(column, t) : QueueLOS_(self.pos, targets_[t].pos);
+    }
+  }
+
+  // Every LOS test of the frame in one pass
+  losClear_.resize(losSegments_.size());
+  LOS::HasLineOfSight(losSegments_, losClear_);
+  losTests_ = static_cast<int>(losSegments_.size());
+
+  for (int o = 0; o < observers_; ++o) {
+    for (int t = 0; t < T; ++t) {
+      const size_t k = static_cast<size_t>(o) * T + t;
+      if (sightingQuery_[k] < 0) continue;
+      Sighting& s = sightings_[k];
+      s.los = losClear_[sightingQuery_[k]] != 0;
+      if (s.los) bits_[static_cast<size_t>(o) * words_ + t / 64] |= std::uint64_t{1} << (t % 64);
+    }
+  }
+}
+
+int VisibilityMatrix::QueueLOS_(const Play::Vector2D& a, const Play::Vector2D& b) {
+  losSegments_.push_back({ a, b });
+  return static_cast<int>(losSegments_.size()) - 1;
+}
+
+int VisibilityMatrix::QueuePairLOS_(const int a, const int b) {
+  const int lo = std::min(a, b), hi = std::max(a, b);
+  int& query = pairQuery_[static_cast<size_t>(lo) * targets_.size() + hi];
+  if (query < 0) query = QueueLOS_(targets_[lo].pos, targets_[hi].pos);
+  return query;
+}
+
+void VisibilityMatrix::VisibleTo(const int observer, std::vector<AI::Contact>& out) const {
+  out.clear();
+  for (int w = 0; w < words_; ++w) {
+    for (std::uint64_t bits = bits_[static_cast<size_t>(observer) * words_ + w]; bits != 0; bits &= bits - 1) {
+      out.push_back(targets_[w * 64 + std::countr_zero(bits)]);
+    }
+  }
+}
+
+} // namespace Sensing::Vision
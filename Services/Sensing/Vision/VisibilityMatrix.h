@@ -0,0 +1,59 @@
+#pragma once
+
+/// @brief Observer x tank visibility (range, cone, LOS) computed once per frame for all agents.
+
+#include <vector>
+#include <cstdint>
+#include "Services/Sensing/Types.h"
+#include "Helper/BoxTable.h"
+
+namespace Sensing::Vision {
+
+// Rows are observers (agents, each with its own vision config), columns the live tanks. Built once per
+// frame by the AI subsystem before anyone thinks; every visibility query of the frame reads it. The LOS
+// test between two tanks is done once and shared by both directions, and all of a frame's LOS tests run
+// as one batch after range/cone culling.
+class VisibilityMatrix {
+public:
+  struct Observer {
+    AI::SelfState self{};
+    SenseConfig   cfg{};
+  };
+
+  void Build(const std::vector<Observer>& observers, const std::vector<AI::Contact>& targets);
+
+  [[nodiscard]] int ObserverCount() const { return observers_; }
+  [[nodiscard]] const std::vector<AI::Contact>& Targets() const { return targets_; }
+
+  [[nodiscard]] bool Visible(const int observer, const int target) const {
+    return (bits_[observer * words_ + target / 64] >> (target % 64)) & 1u;
+  }
+  [[nodiscard]] const Sighting& At(const int observer, const int target) const {
+    return sightings_[observer * targets_.size() + target];
+  }
+
+  // Targets the observer sees, in column order
+  void VisibleTo(int observer, std::vector<AI::Contact>& out) const;
+
+  // LOS tests the last Build ran (pairs culled by range/cone or shared need none)
+  [[nodiscard]] int LosTests() const { return losTests_; }
+
+private:
+  // Index of the batched LOS query for segment a-b, queued on first use
+  int QueueLOS_(const Play::Vector2D& a, const Play::Vector2D& b);
+  // Same, shared by both directions of a pair of targets
+  int QueuePairLOS_(int a, int b);
+
+  int observers_ = 0;
+  int words_ = 0; // 64-bit words per row of bits_
+  std::vector<AI::Contact>   targets_{};
+  std::vector<Sighting>      sightings_{}; // observer-major
+  std::vector<std::uint64_t> bits_{};
+  std::vector<int>           pairQuery_{}; // targets x targets, upper triangle used (-1 = not queued)
+  std::vector<int>           sightingQuery_{}; // per sighting: its LOS query (-1 = culled)
+  std::vector<Geom::Segment> losSegments_{};
+  std::vector<std::uint8_t>  losClear_{};
+  int losTests_ = 0;
+};
+
+} // namespace Sensing::Vision
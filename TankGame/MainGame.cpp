@@ -70,6 +70,8 @@ void MainGameEntry( PLAY_IGNORE_COMMAND_LINE ) {
         params.safetyMargin   = 6.0f;
         params.outerInset     = params.tankRadius + params.safetyMargin;
         params.turnRadius     = 28.0f;
+        params.precomputeAllPairs = true; // arena graph is small; plan paths by table lookup
+        params.navCachePath       = "navgraph.bin"; // next to the executable (working dir, like Data/)
 
         g_ai->pathfinder().SetConfig(params);
         g_ai->pathfinder().Rebuild();